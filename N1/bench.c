@@ -0,0 +1,277 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "functions.h"
+
+#define BENCH_VALUES 65536
+#define BENCH_ROUNDS 3
+#define SAMPLE_OPS 64
+#define BENCH_SAMPLES (BENCH_ROUNDS * BENCH_VALUES / SAMPLE_OPS)
+#define DEFAULT_CSV_PATH "bench.csv"
+
+/*
+ * The bench target links with --wrap for the allocator entry points so
+ * every allocation made inside a timed region is counted.
+ */
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* pointer, size_t size);
+
+static size_t allocation_count = 0;
+
+void* __wrap_malloc(size_t size) {
+    allocation_count++;
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    allocation_count++;
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* pointer, size_t size) {
+    allocation_count++;
+    return __real_realloc(pointer, size);
+}
+
+typedef enum {
+    DISTRIBUTION_UNIFORM,
+    DISTRIBUTION_SMALL,
+    DISTRIBUTION_MAX
+} Distribution;
+
+static const char* const distribution_names[] = {"uniform", "small", "max"};
+
+typedef struct {
+    const unsigned int* values;
+    const char* const* strings;
+    int r;
+    ConversionStatus (*fixed)(unsigned int, char**);
+    char* buffer;
+    size_t buffer_size;
+    size_t* offsets;
+    unsigned int* decoded;
+    ConversionArena* arena;
+} BenchContext;
+
+typedef void (*BenchOp)(const BenchContext* context, size_t begin, size_t count);
+
+static double elapsed_ns(const struct timespec* start, const struct timespec* end) {
+    return (double)(end->tv_sec - start->tv_sec) * 1e9 + (double)(end->tv_nsec - start->tv_nsec);
+}
+
+static unsigned int next_random(unsigned int* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void fill_values(unsigned int* values, const Distribution distribution) {
+    unsigned int state = 2463534242u;
+    for (int i = 0; i < BENCH_VALUES; i++) {
+        switch (distribution) {
+            case DISTRIBUTION_UNIFORM: values[i] = next_random(&state); break;
+            case DISTRIBUTION_SMALL: values[i] = next_random(&state) & 0xFFu; break;
+            default: values[i] = 0xFFFFFFFFu; break;
+        }
+    }
+}
+
+static void op_convert(const BenchContext* context, const size_t begin, const size_t count) {
+    for (size_t i = begin; i < begin + count; i++) {
+        char* result = NULL;
+        convert_to_base(context->values[i], context->r, &result);
+        free(result);
+    }
+}
+
+static void op_fixed(const BenchContext* context, const size_t begin, const size_t count) {
+    for (size_t i = begin; i < begin + count; i++) {
+        char* result = NULL;
+        context->fixed(context->values[i], &result);
+        free(result);
+    }
+}
+
+static void op_u64(const BenchContext* context, const size_t begin, const size_t count) {
+    for (size_t i = begin; i < begin + count; i++) {
+        char* result = NULL;
+        convert_to_base_u64(context->values[i], context->r, &result);
+        free(result);
+    }
+}
+
+static void op_arena(const BenchContext* context, const size_t begin, const size_t count) {
+    conversion_arena_reset(context->arena);
+    for (size_t i = begin; i < begin + count; i++) {
+        char* result = NULL;
+        convert_to_base_arena(context->values[i], context->r, context->arena, &result);
+    }
+}
+
+static void op_batch(const BenchContext* context, const size_t begin, const size_t count) {
+    convert_to_base_batch(context->values + begin, count, context->r, context->buffer,
+                          context->buffer_size, context->offsets, NULL);
+}
+
+static void op_decode(const BenchContext* context, const size_t begin, const size_t count) {
+    convert_from_base_batch(context->strings + begin, count, context->r,
+                            context->decoded + begin, NULL);
+}
+
+static int compare_doubles(const void* left, const void* right) {
+    const double a = *(const double*)left;
+    const double b = *(const double*)right;
+    return (a > b) - (a < b);
+}
+
+/* Times SAMPLE_OPS operations per sample after one untimed warm-up pass. */
+static double measure(const BenchContext* context, const BenchOp op, double* samples) {
+    for (size_t begin = 0; begin < BENCH_VALUES; begin += SAMPLE_OPS) {
+        op(context, begin, SAMPLE_OPS);
+    }
+
+    const size_t allocations_before = allocation_count;
+    size_t sample = 0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (size_t begin = 0; begin < BENCH_VALUES; begin += SAMPLE_OPS) {
+            struct timespec start, end;
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            op(context, begin, SAMPLE_OPS);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            samples[sample++] = elapsed_ns(&start, &end) / SAMPLE_OPS;
+        }
+    }
+
+    qsort(samples, BENCH_SAMPLES, sizeof(double), compare_doubles);
+    return (double)(allocation_count - allocations_before) / ((double)BENCH_ROUNDS * BENCH_VALUES);
+}
+
+static void report(FILE* csv, const char* path, const char* kernel, const int r,
+                   const Distribution distribution, const double* samples, const double allocs_per_op) {
+    const double p50 = samples[BENCH_SAMPLES / 2];
+    const double p99 = samples[(size_t)(BENCH_SAMPLES * 0.99)];
+
+    printf("%-8s %-7s %-2d %-8s %10.2f %10.2f %10.2f\n", path, kernel, r,
+           distribution_names[distribution], p50, p99, allocs_per_op);
+    if (csv != NULL) {
+        fprintf(csv, "%s,%s,%d,%s,%.3f,%.3f,%.3f\n", path, kernel, r,
+                distribution_names[distribution], p50, p99, allocs_per_op);
+    }
+}
+
+static const char* kernel_name(const ConversionKernel kernel) {
+    switch (kernel) {
+        case CONVERSION_KERNEL_SCALAR: return "scalar";
+        case CONVERSION_KERNEL_SSE2: return "sse2";
+        case CONVERSION_KERNEL_AVX2: return "avx2";
+        default: return "auto";
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* csv_path = argc > 1 ? argv[1] : DEFAULT_CSV_PATH;
+    const size_t buffer_size = (size_t)BENCH_VALUES * 33;
+    unsigned int* values = (unsigned int*)malloc(BENCH_VALUES * sizeof(unsigned int));
+    unsigned int* decoded = (unsigned int*)malloc(BENCH_VALUES * sizeof(unsigned int));
+    size_t* offsets = (size_t*)malloc(BENCH_VALUES * sizeof(size_t));
+    char* buffer = (char*)malloc(buffer_size);
+    char* encoded = (char*)malloc(buffer_size);
+    const char** strings = (const char**)malloc(BENCH_VALUES * sizeof(const char*));
+    double* samples = (double*)malloc(BENCH_SAMPLES * sizeof(double));
+    FILE* csv = fopen(csv_path, "w");
+    ConversionArena arena;
+    const ConversionStatus arena_status = conversion_arena_init(&arena, (size_t)SAMPLE_OPS * 33);
+    int failed = 0;
+
+    if (values == NULL || decoded == NULL || offsets == NULL || buffer == NULL ||
+        encoded == NULL || strings == NULL || samples == NULL ||
+        arena_status != CONVERSION_OK) {
+        printf("Error: cannot allocate benchmark buffers\n");
+        failed = 1;
+    }
+    if (csv == NULL) {
+        printf("Error: cannot open '%s' for writing\n", csv_path);
+        failed = 1;
+    }
+
+    ConversionStatus (*const fixed[])(unsigned int, char**) = {
+        convert_to_base_r1, convert_to_base_r2, convert_to_base_r3, convert_to_base_r4, convert_to_base_r5
+    };
+    const ConversionKernel kernels[] = {CONVERSION_KERNEL_SCALAR, CONVERSION_KERNEL_SSE2,
+                                        CONVERSION_KERNEL_AVX2, CONVERSION_KERNEL_AUTO};
+    const size_t kernel_count = sizeof(kernels) / sizeof(kernels[0]);
+
+    if (!failed) {
+        fprintf(csv, "path,kernel,r,distribution,ns_p50,ns_p99,allocs_per_op\n");
+        printf("%-8s %-7s %-2s %-8s %10s %10s %10s\n", "path", "kernel", "r", "dist",
+               "p50 ns/op", "p99 ns/op", "allocs/op");
+    }
+
+    for (int d = DISTRIBUTION_UNIFORM; !failed && d <= DISTRIBUTION_MAX; d++) {
+        fill_values(values, (Distribution)d);
+
+        for (int r = 1; r <= 5; r++) {
+            BenchContext context;
+            context.values = values;
+            context.strings = strings;
+            context.r = r;
+            context.fixed = fixed[r - 1];
+            context.buffer = buffer;
+            context.buffer_size = buffer_size;
+            context.offsets = offsets;
+            context.decoded = decoded;
+            context.arena = &arena;
+
+            set_conversion_kernel(CONVERSION_KERNEL_AUTO);
+            double allocs = measure(&context, op_convert, samples);
+            report(csv, "convert", "auto", r, (Distribution)d, samples, allocs);
+            allocs = measure(&context, op_fixed, samples);
+            report(csv, "fixed", "auto", r, (Distribution)d, samples, allocs);
+            allocs = measure(&context, op_u64, samples);
+            report(csv, "u64", "auto", r, (Distribution)d, samples, allocs);
+            allocs = measure(&context, op_arena, samples);
+            report(csv, "arena", "auto", r, (Distribution)d, samples, allocs);
+
+            convert_to_base_batch(values, BENCH_VALUES, r, encoded, buffer_size, offsets, NULL);
+            for (int i = 0; i < BENCH_VALUES; i++) {
+                strings[i] = encoded + offsets[i];
+            }
+
+            for (size_t k = 0; k < kernel_count; k++) {
+                if (set_conversion_kernel(kernels[k]) != kernels[k]) {
+                    continue;
+                }
+                allocs = measure(&context, op_batch, samples);
+                report(csv, "batch", kernel_name(kernels[k]), r, (Distribution)d, samples, allocs);
+
+                memset(decoded, 0, BENCH_VALUES * sizeof(unsigned int));
+                allocs = measure(&context, op_decode, samples);
+                report(csv, "decode", kernel_name(kernels[k]), r, (Distribution)d, samples, allocs);
+                if (memcmp(values, decoded, BENCH_VALUES * sizeof(unsigned int)) != 0) {
+                    printf("Error: round trip mismatch for r=%d kernel %s\n", r, kernel_name(kernels[k]));
+                    failed = 1;
+                }
+            }
+        }
+    }
+
+    set_conversion_kernel(CONVERSION_KERNEL_AUTO);
+    if (csv != NULL) {
+        fclose(csv);
+        if (!failed) {
+            printf("\nResults written to %s (arena high water %zu bytes)\n", csv_path, arena.high_water);
+        }
+    }
+    free(values);
+    free(decoded);
+    free(offsets);
+    free(buffer);
+    free(encoded);
+    free(strings);
+    free(samples);
+    conversion_arena_destroy(&arena);
+    return failed;
+}
\ No newline at end of file
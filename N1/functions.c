@@ -1,55 +1,795 @@
+#include <limits.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include "functions.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CONVERSION_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+static const char alphabet[] = "0123456789ABCDEFGHIJKLMNOPQRSTUV";
+static const char lowercase_alphabet[] = "0123456789abcdefghijklmnopqrstuv";
+
+static ConversionKernel active_kernel = CONVERSION_KERNEL_AUTO;
+
+/* Bit length of n, treating 0 as one bit wide so that it prints as "0". */
+static int bit_width(const unsigned int n) {
+#if defined(__GNUC__)
+    return (int)(sizeof(unsigned int) * CHAR_BIT) - __builtin_clz(n | 1u);
+#else
+    unsigned int temp = n | 1u;
+    int bits = 0;
+    while (temp != 0) {
+        temp = temp >> 1;
+        bits++;
+    }
+    return bits;
+#endif
+}
+
+static int bit_width_u64(const uint64_t n) {
+#if defined(__GNUC__)
+    return 64 - __builtin_clzll((unsigned long long)(n | 1u));
+#else
+    const unsigned int high = (unsigned int)(n >> 32);
+    return high != 0 ? 32 + bit_width(high) : bit_width((unsigned int)n);
+#endif
+}
+
+static int count_digits(const unsigned int n, const int r) {
+    return (bit_width(n) + r - 1) / r;
+}
+
+static int count_digits_u64(const uint64_t n, const int r) {
+    return (bit_width_u64(n) + r - 1) / r;
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 8
+#define CONVERSION_UNROLL _Pragma("GCC unroll 32")
+#else
+#define CONVERSION_UNROLL
+#endif
+
+#define CONVERSION_MAX_DIGITS(R) ((int)((sizeof(unsigned int) * CHAR_BIT + (R) - 1) / (R)))
+
+/*
+ * Scalar digit writer with the radix fixed at compile time: mask, shift and
+ * the full-width digit count are constants, so the loop unrolls completely.
+ */
+#define DEFINE_FIXED_DIGIT_WRITER(R) \
+    static void write_digits_r##R(unsigned int n, char* out, const int digits_count) { \
+        char digits[CONVERSION_MAX_DIGITS(R)]; \
+        CONVERSION_UNROLL \
+        for (int index = CONVERSION_MAX_DIGITS(R) - 1; index >= 0; index--) { \
+            digits[index] = alphabet[n & ((1u << (R)) - 1)]; \
+            n = n >> (R); \
+        } \
+        memcpy(out, digits + CONVERSION_MAX_DIGITS(R) - digits_count, (size_t)digits_count); \
+    }
+
+DEFINE_FIXED_DIGIT_WRITER(1)
+DEFINE_FIXED_DIGIT_WRITER(3)
+
+/*
+ * Multi-digit tables for the radices whose digits pack evenly into a byte
+ * (r = 2, 4) or a 10-bit group (r = 5): one lookup emits several characters.
+ */
+static char byte_to_base4[256][4];
+static char byte_to_base16[256][2];
+static char group_to_base32[1024][2];
+
+#if defined(__GNUC__)
+#define CONVERSION_CONSTRUCTOR __attribute__((constructor))
+#else
+#define CONVERSION_CONSTRUCTOR
+static int digit_tables_ready = 0;
+#endif
+
+CONVERSION_CONSTRUCTOR
+static void init_digit_tables(void) {
+    for (unsigned int byte = 0; byte < 256; byte++) {
+        for (int i = 0; i < 4; i++) {
+            byte_to_base4[byte][i] = alphabet[(byte >> (6 - 2 * i)) & 0x3u];
+        }
+        byte_to_base16[byte][0] = alphabet[byte >> 4];
+        byte_to_base16[byte][1] = alphabet[byte & 0xFu];
+    }
+    for (unsigned int group = 0; group < 1024; group++) {
+        group_to_base32[group][0] = alphabet[group >> 5];
+        group_to_base32[group][1] = alphabet[group & 0x1Fu];
+    }
+#if !defined(__GNUC__)
+    digit_tables_ready = 1;
+#endif
+}
+
+static void write_digits_table_r2(const unsigned int n, char* out, const int digits_count) {
+    char digits[16];
+    memcpy(digits, byte_to_base4[n >> 24], 4);
+    memcpy(digits + 4, byte_to_base4[(n >> 16) & 0xFFu], 4);
+    memcpy(digits + 8, byte_to_base4[(n >> 8) & 0xFFu], 4);
+    memcpy(digits + 12, byte_to_base4[n & 0xFFu], 4);
+    memcpy(out, digits + 16 - digits_count, (size_t)digits_count);
+}
+
+static void write_digits_table_r4(const unsigned int n, char* out, const int digits_count) {
+    char digits[8];
+    memcpy(digits, byte_to_base16[n >> 24], 2);
+    memcpy(digits + 2, byte_to_base16[(n >> 16) & 0xFFu], 2);
+    memcpy(digits + 4, byte_to_base16[(n >> 8) & 0xFFu], 2);
+    memcpy(digits + 6, byte_to_base16[n & 0xFFu], 2);
+    memcpy(out, digits + 8 - digits_count, (size_t)digits_count);
+}
+
+/* 32 bits make 7 base-32 digits: the top two bits and three 10-bit groups. */
+static void write_digits_table_r5(const unsigned int n, char* out, const int digits_count) {
+    char digits[8];
+    memcpy(digits, group_to_base32[n >> 30], 2);
+    memcpy(digits + 2, group_to_base32[(n >> 20) & 0x3FFu], 2);
+    memcpy(digits + 4, group_to_base32[(n >> 10) & 0x3FFu], 2);
+    memcpy(digits + 6, group_to_base32[n & 0x3FFu], 2);
+    memcpy(out, digits + 8 - digits_count, (size_t)digits_count);
+}
+
+static void write_digits_scalar(const unsigned int n, const int r, char* out, const int digits_count) {
+#if !defined(__GNUC__)
+    if (!digit_tables_ready) {
+        init_digit_tables();
+    }
+#endif
+    switch (r) {
+        case 1: write_digits_r1(n, out, digits_count); break;
+        case 2: write_digits_table_r2(n, out, digits_count); break;
+        case 3: write_digits_r3(n, out, digits_count); break;
+        case 4: write_digits_table_r4(n, out, digits_count); break;
+        default: write_digits_table_r5(n, out, digits_count); break;
+    }
+}
+
+#if defined(CONVERSION_HAVE_X86) && defined(__SSE2__)
+/* Maps digit bytes 0..31 onto the alphabet: '0' + d, plus 7 to skip from '9' to 'A'. */
+static __m128i digits_to_ascii_sse2(const __m128i digits) {
+    const __m128i letters = _mm_cmpgt_epi8(digits, _mm_set1_epi8(9));
+    const __m128i ascii = _mm_add_epi8(digits, _mm_set1_epi8('0'));
+    return _mm_add_epi8(ascii, _mm_and_si128(letters, _mm_set1_epi8(7)));
+}
+
+/* r = 4 only: splits the byte-swapped value into its eight nibbles at once. */
+static void write_digits_sse2(const unsigned int n, const int r, char* out, const int digits_count) {
+    if (r != 4) {
+        write_digits_scalar(n, r, out, digits_count);
+        return;
+    }
+
+    const unsigned int swapped = ((n & 0xFFu) << 24) | ((n & 0xFF00u) << 8) |
+                                 ((n >> 8) & 0xFF00u) | (n >> 24);
+    const __m128i low_mask = _mm_set1_epi8(0x0F);
+    const __m128i bytes = _mm_cvtsi32_si128((int)swapped);
+    const __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), low_mask);
+    const __m128i low = _mm_and_si128(bytes, low_mask);
+    const __m128i nibbles = _mm_unpacklo_epi8(high, low);
+
+    char digits[16];
+    _mm_storeu_si128((__m128i*)digits, digits_to_ascii_sse2(nibbles));
+    memcpy(out, digits + 8 - digits_count, (size_t)digits_count);
+}
+#endif
+
+#if defined(CONVERSION_HAVE_X86)
+/* Extracts all (up to 32) digits with per-lane variable shifts, eight per vector. */
+__attribute__((target("avx2")))
+static void write_digits_avx2(const unsigned int n, const int r, char* out, const int digits_count) {
+    const __m256i value = _mm256_set1_epi32((int)n);
+    const __m256i mask = _mm256_set1_epi32((1 << r) - 1);
+    const __m256i block_step = _mm256_set1_epi32(8 * r);
+    __m256i shift = _mm256_sub_epi32(_mm256_set1_epi32((digits_count - 1) * r),
+                                     _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                                        _mm256_set1_epi32(r)));
+
+    __m256i blocks[4];
+    for (int i = 0; i < 4; i++) {
+        blocks[i] = _mm256_and_si256(_mm256_srlv_epi32(value, shift), mask);
+        shift = _mm256_sub_epi32(shift, block_step);
+    }
+
+    const __m256i words_low = _mm256_packus_epi32(blocks[0], blocks[1]);
+    const __m256i words_high = _mm256_packus_epi32(blocks[2], blocks[3]);
+    __m256i digits = _mm256_packus_epi16(words_low, words_high);
+    digits = _mm256_permutevar8x32_epi32(digits, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+
+    const __m256i letters = _mm256_cmpgt_epi8(digits, _mm256_set1_epi8(9));
+    digits = _mm256_add_epi8(digits, _mm256_set1_epi8('0'));
+    digits = _mm256_add_epi8(digits, _mm256_and_si256(letters, _mm256_set1_epi8(7)));
+
+    char ascii[32];
+    _mm256_storeu_si256((__m256i*)ascii, digits);
+    memcpy(out, ascii, (size_t)digits_count);
+}
+#endif
+
+static int kernel_supported(const ConversionKernel kernel) {
+    switch (kernel) {
+        case CONVERSION_KERNEL_SCALAR:
+            return 1;
+#if defined(CONVERSION_HAVE_X86) && defined(__SSE2__)
+        case CONVERSION_KERNEL_SSE2:
+            return 1;
+#endif
+#if defined(CONVERSION_HAVE_X86)
+        case CONVERSION_KERNEL_AVX2:
+            return __builtin_cpu_supports("avx2");
+#endif
+        default:
+            return 0;
+    }
+}
+
+ConversionKernel set_conversion_kernel(const ConversionKernel kernel) {
+    if (kernel == CONVERSION_KERNEL_AUTO || kernel_supported(kernel)) {
+        active_kernel = kernel;
+    } else {
+        active_kernel = CONVERSION_KERNEL_SCALAR;
+    }
+    return active_kernel;
+}
+
+ConversionKernel get_conversion_kernel(void) {
+    return active_kernel;
+}
+
+/*
+ * AUTO uses each vector kernel only where it beats the scalar path: the
+ * variable-shift AVX2 kernel for the 32-digit r = 1 strings and the nibble
+ * split for r = 4. The r = 2 and r = 5 lookup tables outrun AVX2, and r = 3
+ * gives too few digits to amortize vector setup.
+ */
+static ConversionKernel auto_kernel(const int r) {
+    if (r == 1 && kernel_supported(CONVERSION_KERNEL_AVX2)) {
+        return CONVERSION_KERNEL_AVX2;
+    }
+    if (r == 4 && kernel_supported(CONVERSION_KERNEL_SSE2)) {
+        return CONVERSION_KERNEL_SSE2;
+    }
+    return CONVERSION_KERNEL_SCALAR;
+}
+
+static void write_digits(const unsigned int n, const int r, char* out, const int digits_count) {
+    ConversionKernel kernel = active_kernel;
+    if (kernel == CONVERSION_KERNEL_AUTO) {
+        kernel = auto_kernel(r);
+    }
+
+    switch (kernel) {
+#if defined(CONVERSION_HAVE_X86) && defined(__SSE2__)
+        case CONVERSION_KERNEL_SSE2:
+            write_digits_sse2(n, r, out, digits_count);
+            break;
+#endif
+#if defined(CONVERSION_HAVE_X86)
+        case CONVERSION_KERNEL_AVX2:
+            write_digits_avx2(n, r, out, digits_count);
+            break;
+#endif
+        default:
+            write_digits_scalar(n, r, out, digits_count);
+            break;
+    }
+    out[digits_count] = '\0';
+}
+
+/*
+ * Per-radix entry points: with R constant, count_digits becomes a shift and
+ * a multiply. write_digits still picks its kernel at run time from
+ * active_kernel, so set_conversion_kernel applies to these paths too.
+ */
+#define DEFINE_FIXED_CONVERTER(R) \
+    ConversionStatus convert_to_base_r##R(const unsigned int n, char** result) { \
+        if (result == NULL) { \
+            return CONVERSION_NULL_POINTER; \
+        } \
+        const int digits_count = count_digits(n, (R)); \
+        *result = (char*)malloc((digits_count + 1) * sizeof(char)); \
+        if (*result == NULL) { \
+            return CONVERSION_MEMORY_ERROR; \
+        } \
+        write_digits(n, (R), *result, digits_count); \
+        return CONVERSION_OK; \
+    } \
+    \
+    static ConversionStatus convert_batch_r##R(const unsigned int* values, const size_t count, \
+                                               char* buffer, const size_t buffer_size, \
+                                               size_t* offsets, ConversionStatus* statuses) { \
+        ConversionStatus batch_status = CONVERSION_OK; \
+        size_t used = 0; \
+        for (size_t i = 0; i < count; i++) { \
+            const size_t digits_count = (size_t)count_digits(values[i], (R)); \
+            if (buffer_size - used < digits_count + 1) { \
+                offsets[i] = CONVERSION_NO_OFFSET; \
+                if (statuses != NULL) { \
+                    statuses[i] = CONVERSION_MEMORY_ERROR; \
+                } \
+                batch_status = CONVERSION_MEMORY_ERROR; \
+                continue; \
+            } \
+            offsets[i] = used; \
+            write_digits(values[i], (R), buffer + used, (int)digits_count); \
+            used += digits_count + 1; \
+            if (statuses != NULL) { \
+                statuses[i] = CONVERSION_OK; \
+            } \
+        } \
+        return batch_status; \
+    }
+
+DEFINE_FIXED_CONVERTER(1)
+DEFINE_FIXED_CONVERTER(2)
+DEFINE_FIXED_CONVERTER(3)
+DEFINE_FIXED_CONVERTER(4)
+DEFINE_FIXED_CONVERTER(5)
+
 ConversionStatus convert_to_base(const unsigned int n, const int r, char** result) {
-    if (result == NULL) {
+    switch (r) {
+        case 1: return convert_to_base_r1(n, result);
+        case 2: return convert_to_base_r2(n, result);
+        case 3: return convert_to_base_r3(n, result);
+        case 4: return convert_to_base_r4(n, result);
+        case 5: return convert_to_base_r5(n, result);
+        default: return result == NULL ? CONVERSION_NULL_POINTER : CONVERSION_INVALID_BASE;
+    }
+}
+
+size_t convert_to_base_length(const unsigned int n, const int r) {
+    if (r < 1 || r > 5) {
+        return 0;
+    }
+    return (size_t)count_digits(n, r);
+}
+
+size_t convert_to_base_length_u64(const uint64_t n, const int r) {
+    if (r < 1 || r > 5) {
+        return 0;
+    }
+    return (size_t)count_digits_u64(n, r);
+}
+
+ConversionStatus convert_to_base_batch(const unsigned int* values, const size_t count, const int r,
+                                       char* buffer, const size_t buffer_size,
+                                       size_t* offsets, ConversionStatus* statuses) {
+    if (values == NULL || buffer == NULL || offsets == NULL) {
         return CONVERSION_NULL_POINTER;
     }
-    
+
     if (r < 1 || r > 5) {
         return CONVERSION_INVALID_BASE;
     }
-    
-    unsigned int base = 1;
-    int i = 0;
-    while (i < r) {
-        base = base << 1;
-        i++;
+
+    switch (r) {
+        case 1: return convert_batch_r1(values, count, buffer, buffer_size, offsets, statuses);
+        case 2: return convert_batch_r2(values, count, buffer, buffer_size, offsets, statuses);
+        case 3: return convert_batch_r3(values, count, buffer, buffer_size, offsets, statuses);
+        case 4: return convert_batch_r4(values, count, buffer, buffer_size, offsets, statuses);
+        default: return convert_batch_r5(values, count, buffer, buffer_size, offsets, statuses);
     }
+}
 
-    if (n == 0) {
-        *result = (char*)malloc(2 * sizeof(char));
-        if (*result == NULL) {
-            return CONVERSION_MEMORY_ERROR;
-        }
-        (*result)[0] = '0';
-        (*result)[1] = '\0';
+ConversionStatus conversion_arena_init(ConversionArena* arena, const size_t capacity) {
+    if (arena == NULL) {
+        return CONVERSION_NULL_POINTER;
+    }
+
+    arena->base = capacity > 0 ? (char*)malloc(capacity) : NULL;
+    arena->capacity = arena->base != NULL ? capacity : 0;
+    arena->used = 0;
+    arena->high_water = 0;
+    return capacity > 0 && arena->base == NULL ? CONVERSION_MEMORY_ERROR : CONVERSION_OK;
+}
+
+void conversion_arena_reset(ConversionArena* arena) {
+    if (arena != NULL) {
+        arena->used = 0;
+    }
+}
+
+void conversion_arena_destroy(ConversionArena* arena) {
+    if (arena != NULL) {
+        free(arena->base);
+        memset(arena, 0, sizeof(*arena));
+    }
+}
+
+ConversionStatus convert_to_base_arena(const unsigned int n, const int r, ConversionArena* arena, char** result) {
+    if (arena == NULL || result == NULL) {
+        return CONVERSION_NULL_POINTER;
+    }
+
+    if (r < 1 || r > 5) {
+        return CONVERSION_INVALID_BASE;
+    }
+
+    const int digits_count = count_digits(n, r);
+    const size_t required = arena->used + (size_t)digits_count + 1;
+    if (required > arena->high_water) {
+        arena->high_water = required;
+    }
+    if (required > arena->capacity) {
+        *result = NULL;
+        return CONVERSION_MEMORY_ERROR;
+    }
+
+    *result = arena->base + arena->used;
+    arena->used = required;
+    write_digits(n, r, *result, digits_count);
+    return CONVERSION_OK;
+}
+
+static size_t formatted_digits(const unsigned int n, const int r, const ConversionFormat* format) {
+    const size_t digits_count = (size_t)count_digits(n, r);
+    return format != NULL && format->min_width > digits_count ? format->min_width : digits_count;
+}
+
+static size_t formatted_separators(const size_t digits_count, const ConversionFormat* format) {
+    return format != NULL && format->group_size > 0 ? (digits_count - 1) / format->group_size : 0;
+}
+
+size_t convert_to_base_formatted_length(const unsigned int n, const int r, const ConversionFormat* format) {
+    if (r < 1 || r > 5) {
+        return 0;
+    }
+    const size_t digits_count = formatted_digits(n, r, format);
+    return digits_count + formatted_separators(digits_count, format);
+}
+
+ConversionStatus convert_to_base_formatted(const unsigned int n, const int r, const ConversionFormat* format,
+                                           char* buffer, const size_t buffer_size, size_t* written) {
+    if (buffer == NULL || written == NULL) {
+        return CONVERSION_NULL_POINTER;
+    }
+
+    if (r < 1 || r > 5) {
+        return CONVERSION_INVALID_BASE;
+    }
+
+    const size_t digits_count = formatted_digits(n, r, format);
+    const size_t length = digits_count + formatted_separators(digits_count, format);
+    *written = length;
+    if (buffer_size < length + 1) {
+        return CONVERSION_MEMORY_ERROR;
+    }
+
+    /* Plain uppercase output keeps the vector and table kernels; padding is one memset. */
+    if (format == NULL || (format->group_size == 0 && !format->lowercase)) {
+        const int natural = count_digits(n, r);
+        memset(buffer, '0', digits_count - (size_t)natural);
+        write_digits(n, r, buffer + digits_count - (size_t)natural, natural);
         return CONVERSION_OK;
     }
 
+    const char* digit_set = format->lowercase ? lowercase_alphabet : alphabet;
+    const unsigned int mask = (1u << r) - 1;
     unsigned int temp = n;
-    int digits_count = 0;
-    while (temp != 0) {
+    size_t group_left = format->group_size > 0 ? format->group_size : digits_count;
+    char* out = buffer + length;
+    *out = '\0';
+    for (size_t i = 0; i < digits_count; i++) {
+        if (group_left == 0) {
+            *--out = format->separator;
+            group_left = format->group_size;
+        }
+        *--out = digit_set[temp & mask];
+        temp = temp >> r;
+        group_left--;
+    }
+
+    return CONVERSION_OK;
+}
+
+/*
+ * For r = 1, 2, 4 a 32-bit half holds a whole number of digits, so both
+ * halves go through the 32-bit kernels; r = 3, 5 straddle the halves.
+ */
+static void write_digits_u64(const uint64_t n, const int r, char* out, const int digits_count) {
+    const unsigned int high = (unsigned int)(n >> 32);
+    const int low_digits = 32 / r;
+
+    if (32 % r == 0 && high != 0) {
+        write_digits(high, r, out, digits_count - low_digits);
+        write_digits((unsigned int)n, r, out + digits_count - low_digits, low_digits);
+        return;
+    }
+    if (high == 0) {
+        write_digits((unsigned int)n, r, out, digits_count);
+        return;
+    }
+
+    const uint64_t mask = ((uint64_t)1 << r) - 1;
+    uint64_t temp = n;
+    for (int index = digits_count - 1; index >= 0; index--) {
+        out[index] = alphabet[temp & mask];
         temp = temp >> r;
-        digits_count++;
     }
+    out[digits_count] = '\0';
+}
+
+ConversionStatus convert_to_base_u64(const uint64_t n, const int r, char** result) {
+    if (result == NULL) {
+        return CONVERSION_NULL_POINTER;
+    }
+
+    if (r < 1 || r > 5) {
+        return CONVERSION_INVALID_BASE;
+    }
+
+    int digits_count = count_digits_u64(n, r);
 
-    const char alphabet[] = "0123456789ABCDEFGHIJKLMNOPQRSTUV";
-    
     *result = (char*)malloc((digits_count + 1) * sizeof(char));
     if (*result == NULL) {
         return CONVERSION_MEMORY_ERROR;
     }
-    (*result)[digits_count] = '\0';
 
-    temp = n;
-    int index = digits_count - 1;
-    while (index >= 0) {
-        unsigned int digit = temp & (base - 1);
-        (*result)[index] = alphabet[digit];
-        temp = temp >> r;
-        index--;
+    write_digits_u64(n, r, *result, digits_count);
+
+    return CONVERSION_OK;
+}
+
+ConversionStatus convert_bytes_to_base(const unsigned char* bytes, const size_t length, const int r,
+                                       char* buffer, const size_t buffer_size, size_t* written) {
+    if ((bytes == NULL && length > 0) || buffer == NULL || written == NULL) {
+        return CONVERSION_NULL_POINTER;
+    }
+
+    if (r < 1 || r > 5) {
+        return CONVERSION_INVALID_BASE;
+    }
+
+    size_t significant = length;
+    while (significant > 0 && bytes[significant - 1] == 0) {
+        significant--;
+    }
+
+    if (significant == 0) {
+        *written = 1;
+        if (buffer_size < 2) {
+            return CONVERSION_MEMORY_ERROR;
+        }
+        buffer[0] = '0';
+        buffer[1] = '\0';
+        return CONVERSION_OK;
+    }
+
+    const size_t bits = (significant - 1) * 8 + (size_t)bit_width(bytes[significant - 1]);
+    const size_t digits_count = (bits + (size_t)r - 1) / (size_t)r;
+    *written = digits_count;
+    if (buffer_size < digits_count + 1) {
+        return CONVERSION_MEMORY_ERROR;
+    }
+
+    char* out = buffer;
+    if (8 % r == 0) {
+        size_t top_bytes = significant % 4 == 0 ? 4 : significant % 4;
+        size_t position = significant - top_bytes;
+        unsigned int word = 0;
+        for (size_t i = significant; i > position; i--) {
+            word = (word << 8) | bytes[i - 1];
+        }
+        int top_digits = count_digits(word, r);
+        write_digits(word, r, out, top_digits);
+        out += top_digits;
+
+        const int word_digits = 32 / r;
+        while (position > 0) {
+            position -= 4;
+            word = (unsigned int)bytes[position] | ((unsigned int)bytes[position + 1] << 8) |
+                   ((unsigned int)bytes[position + 2] << 16) | ((unsigned int)bytes[position + 3] << 24);
+            write_digits(word, r, out, word_digits);
+            out += word_digits;
+        }
+        return CONVERSION_OK;
+    }
+
+    size_t position = significant - 1;
+    unsigned int accumulator = bytes[position];
+    int accumulated_bits = bit_width(accumulator);
+    int needed = (int)(bits - (digits_count - 1) * (size_t)r);
+    for (size_t i = 0; i < digits_count; i++) {
+        while (accumulated_bits < needed) {
+            accumulator = (accumulator << 8) | bytes[--position];
+            accumulated_bits += 8;
+        }
+        accumulated_bits -= needed;
+        out[i] = alphabet[(accumulator >> accumulated_bits) & ((1u << needed) - 1)];
+        accumulator &= (1u << accumulated_bits) - 1;
+        needed = r;
     }
+    out[digits_count] = '\0';
 
     return CONVERSION_OK;
+}
+
+static int char_to_digit(const unsigned char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'A' && c <= 'V') {
+        return c - 'A' + 10;
+    }
+    return 32;
+}
+
+/*
+ * Each decode_chunk_* turns up to one register of characters into digit
+ * values and reports whether every one of them is valid for base.
+ */
+static int decode_chunk_scalar(const char* src, const size_t length, const int base,
+                               unsigned char* digits) {
+    int valid = 1;
+    for (size_t i = 0; i < length; i++) {
+        int digit = char_to_digit((unsigned char)src[i]);
+        valid &= digit < base;
+        digits[i] = (unsigned char)digit;
+    }
+    return valid;
+}
+
+#if defined(CONVERSION_HAVE_X86)
+/*
+ * The vector decoders load a whole register straight from the string. Bytes
+ * past the terminator are masked out of the result, and a load that stays in
+ * src's page cannot fault, so only loads that would cross a page go through a
+ * padded copy. The over-read is deliberate, hence no_sanitize_address.
+ */
+#define CONVERSION_PAGE_SIZE 4096u
+
+static int load_stays_in_page(const char* src, const size_t width) {
+    return ((uintptr_t)src & (CONVERSION_PAGE_SIZE - 1)) <= CONVERSION_PAGE_SIZE - width;
+}
+#endif
+
+#if defined(CONVERSION_HAVE_X86) && defined(__SSE2__)
+__attribute__((no_sanitize_address))
+static int decode_chunk_sse2(const char* src, const size_t length, const int base,
+                             unsigned char* digits) {
+    __m128i bytes;
+    if (load_stays_in_page(src, 16)) {
+        bytes = _mm_loadu_si128((const __m128i*)src);
+    } else {
+        char padded[16];
+        memset(padded, '0', sizeof(padded));
+        memcpy(padded, src, length);
+        bytes = _mm_loadu_si128((const __m128i*)padded);
+    }
+
+    const __m128i offset = _mm_sub_epi8(bytes, _mm_set1_epi8('0'));
+    const __m128i letter = _mm_cmpeq_epi8(_mm_max_epu8(offset, _mm_set1_epi8(17)), offset);
+    const __m128i decimal = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(9)), offset);
+    const __m128i digit = _mm_sub_epi8(offset, _mm_and_si128(letter, _mm_set1_epi8(7)));
+    const __m128i in_base = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8((char)(base - 1))), digit);
+    const __m128i valid = _mm_and_si128(in_base, _mm_or_si128(letter, decimal));
+
+    _mm_storeu_si128((__m128i*)digits, digit);
+    const unsigned int ignored = 0xFFFFu << length;
+    return (((unsigned int)_mm_movemask_epi8(valid) | ignored) & 0xFFFFu) == 0xFFFFu;
+}
+#endif
+
+#if defined(CONVERSION_HAVE_X86)
+__attribute__((target("avx2"), no_sanitize_address))
+static int decode_chunk_avx2(const char* src, const size_t length, const int base,
+                             unsigned char* digits) {
+    __m256i bytes;
+    if (load_stays_in_page(src, 32)) {
+        bytes = _mm256_loadu_si256((const __m256i*)src);
+    } else {
+        char padded[32];
+        memset(padded, '0', sizeof(padded));
+        memcpy(padded, src, length);
+        bytes = _mm256_loadu_si256((const __m256i*)padded);
+    }
+
+    const __m256i offset = _mm256_sub_epi8(bytes, _mm256_set1_epi8('0'));
+    const __m256i letter = _mm256_cmpeq_epi8(_mm256_max_epu8(offset, _mm256_set1_epi8(17)), offset);
+    const __m256i decimal = _mm256_cmpeq_epi8(_mm256_min_epu8(offset, _mm256_set1_epi8(9)), offset);
+    const __m256i digit = _mm256_sub_epi8(offset, _mm256_and_si256(letter, _mm256_set1_epi8(7)));
+    const __m256i in_base = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8((char)(base - 1))),
+                                              digit);
+    const __m256i valid = _mm256_and_si256(in_base, _mm256_or_si256(letter, decimal));
+
+    _mm256_storeu_si256((__m256i*)digits, digit);
+    const unsigned int ignored = length < 32 ? ~0u << length : 0u;
+    return ((unsigned int)_mm256_movemask_epi8(valid) | ignored) == ~0u;
+}
+#endif
+
+static ConversionStatus parse_digits(const char* str, const int r, unsigned int* value) {
+    const size_t length = strlen(str);
+    if (length == 0) {
+        return CONVERSION_INVALID_DIGIT;
+    }
+
+    /*
+     * Under AUTO, SSE2 decodes every radix: 16 lanes hold each 32-bit string
+     * but the binary ones, and two SSE2 chunks measure no slower than one AVX2
+     * chunk for those.
+     */
+    ConversionKernel kernel = active_kernel;
+    if (kernel == CONVERSION_KERNEL_AUTO) {
+        kernel = CONVERSION_KERNEL_SSE2;
+    }
+    const size_t chunk_size = kernel == CONVERSION_KERNEL_AVX2 ? 32 : 16;
+    const int base = 1 << r;
+
+    unsigned int result = 0;
+    for (size_t start = 0; start < length; start += chunk_size) {
+        const size_t chunk = length - start < chunk_size ? length - start : chunk_size;
+        unsigned char digits[32];
+        int valid;
+
+        switch (kernel) {
+#if defined(CONVERSION_HAVE_X86) && defined(__SSE2__)
+            case CONVERSION_KERNEL_SSE2:
+                valid = decode_chunk_sse2(str + start, chunk, base, digits);
+                break;
+#endif
+#if defined(CONVERSION_HAVE_X86)
+            case CONVERSION_KERNEL_AVX2:
+                valid = decode_chunk_avx2(str + start, chunk, base, digits);
+                break;
+#endif
+            default:
+                valid = decode_chunk_scalar(str + start, chunk, base, digits);
+                break;
+        }
+        if (!valid) {
+            return CONVERSION_INVALID_DIGIT;
+        }
+
+        for (size_t i = 0; i < chunk; i++) {
+            if (result > (UINT_MAX >> r)) {
+                return CONVERSION_OVERFLOW;
+            }
+            result = (result << r) | digits[i];
+        }
+    }
+
+    *value = result;
+    return CONVERSION_OK;
+}
+
+ConversionStatus convert_from_base(const char* str, const int r, unsigned int* value) {
+    if (str == NULL || value == NULL) {
+        return CONVERSION_NULL_POINTER;
+    }
+
+    if (r < 1 || r > 5) {
+        return CONVERSION_INVALID_BASE;
+    }
+
+    return parse_digits(str, r, value);
+}
+
+ConversionStatus convert_from_base_batch(const char* const* strings, const size_t count, const int r,
+                                         unsigned int* values, ConversionStatus* statuses) {
+    if (strings == NULL || values == NULL) {
+        return CONVERSION_NULL_POINTER;
+    }
+
+    if (r < 1 || r > 5) {
+        return CONVERSION_INVALID_BASE;
+    }
+
+    ConversionStatus batch_status = CONVERSION_OK;
+    for (size_t i = 0; i < count; i++) {
+        values[i] = 0;
+        ConversionStatus status = strings[i] == NULL ? CONVERSION_NULL_POINTER
+                                                     : parse_digits(strings[i], r, &values[i]);
+        if (statuses != NULL) {
+            statuses[i] = status;
+        }
+        if (status != CONVERSION_OK && batch_status == CONVERSION_OK) {
+            batch_status = status;
+        }
+    }
+
+    return batch_status;
 }
\ No newline at end of file
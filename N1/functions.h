@@ -1,13 +1,124 @@
 #ifndef FUNCTIONS_H
 #define FUNCTIONS_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 typedef enum {
     CONVERSION_OK = 0,
     CONVERSION_INVALID_BASE = 1,
     CONVERSION_MEMORY_ERROR = 2,
-    CONVERSION_NULL_POINTER = 3
+    CONVERSION_NULL_POINTER = 3,
+    CONVERSION_INVALID_DIGIT = 4,
+    CONVERSION_OVERFLOW = 5
 } ConversionStatus;
 
+typedef enum {
+    CONVERSION_KERNEL_AUTO = 0,
+    CONVERSION_KERNEL_SCALAR = 1,
+    CONVERSION_KERNEL_SSE2 = 2,
+    CONVERSION_KERNEL_AVX2 = 3
+} ConversionKernel;
+
 ConversionStatus convert_to_base(const unsigned int n, const int r, char** result);
 
+/* Fixed-radix variants of convert_to_base for call sites that know r up front. */
+ConversionStatus convert_to_base_r1(const unsigned int n, char** result);
+ConversionStatus convert_to_base_r2(const unsigned int n, char** result);
+ConversionStatus convert_to_base_r3(const unsigned int n, char** result);
+ConversionStatus convert_to_base_r4(const unsigned int n, char** result);
+ConversionStatus convert_to_base_r5(const unsigned int n, char** result);
+
+/*
+ * Number of digits convert_to_base produces for n, not counting the
+ * terminator, computed in constant time. Returns 0 for an invalid r.
+ */
+size_t convert_to_base_length(const unsigned int n, const int r);
+size_t convert_to_base_length_u64(const uint64_t n, const int r);
+
+/*
+ * Converts count values into one caller-provided buffer without per-value
+ * allocation. Result i is the NUL-terminated string at buffer + offsets[i].
+ * Values that do not fit get CONVERSION_MEMORY_ERROR in statuses (which may
+ * be NULL), CONVERSION_NO_OFFSET in offsets, and the whole call reports
+ * CONVERSION_MEMORY_ERROR.
+ */
+#define CONVERSION_NO_OFFSET ((size_t)-1)
+
+ConversionStatus convert_to_base_batch(const unsigned int* values, const size_t count, const int r,
+                                       char* buffer, const size_t buffer_size,
+                                       size_t* offsets, ConversionStatus* statuses);
+
+/*
+ * Output layout for convert_to_base_formatted. Digits are zero-padded on the
+ * left to min_width; a group_size of 0 disables grouping, otherwise separator
+ * is inserted between every group_size digits counted from the right.
+ */
+typedef struct {
+    size_t min_width;
+    size_t group_size;
+    char separator;
+    int lowercase;
+} ConversionFormat;
+
+/* Characters convert_to_base_formatted writes for n, not counting the terminator. */
+size_t convert_to_base_formatted_length(const unsigned int n, const int r, const ConversionFormat* format);
+
+/*
+ * Writes n padded, grouped and cased per format (NULL means plain digits) in
+ * one pass into buffer. *written receives the length as in convert_bytes_to_base.
+ */
+ConversionStatus convert_to_base_formatted(const unsigned int n, const int r, const ConversionFormat* format,
+                                           char* buffer, const size_t buffer_size, size_t* written);
+
+/*
+ * Bump allocator for conversion results. Strings from convert_to_base_arena
+ * live until the next reset; high_water is the largest number of bytes ever
+ * requested between resets, including requests that did not fit.
+ */
+typedef struct {
+    char* base;
+    size_t capacity;
+    size_t used;
+    size_t high_water;
+} ConversionArena;
+
+ConversionStatus conversion_arena_init(ConversionArena* arena, const size_t capacity);
+void conversion_arena_reset(ConversionArena* arena);
+void conversion_arena_destroy(ConversionArena* arena);
+
+ConversionStatus convert_to_base_arena(const unsigned int n, const int r, ConversionArena* arena, char** result);
+
+ConversionStatus convert_to_base_u64(const uint64_t n, const int r, char** result);
+
+/*
+ * Converts an unsigned little-endian integer of any length, streaming digits
+ * straight into buffer. *written receives the digit count (excluding the
+ * terminator) even when CONVERSION_MEMORY_ERROR reports buffer is too small.
+ */
+ConversionStatus convert_bytes_to_base(const unsigned char* bytes, const size_t length, const int r,
+                                       char* buffer, const size_t buffer_size, size_t* written);
+
+/*
+ * Parses a base-2^r string written with the converter's alphabet. Leading
+ * zeros are accepted; values beyond UINT_MAX report CONVERSION_OVERFLOW.
+ */
+ConversionStatus convert_from_base(const char* str, const int r, unsigned int* value);
+
+/*
+ * Parses count strings, validating each one a SIMD register at a time.
+ * statuses (may be NULL) gets the per-string result; the call returns the
+ * first failure, if any. Failed entries leave 0 in values.
+ */
+ConversionStatus convert_from_base_batch(const char* const* strings, const size_t count, const int r,
+                                         unsigned int* values, ConversionStatus* statuses);
+
+/*
+ * Selects the digit extraction kernel used by every converter. AUTO (the
+ * default) picks, per radix, the fastest kernel the CPU supports at runtime;
+ * an unsupported request falls back to SCALAR. Returns the kernel in effect.
+ */
+ConversionKernel set_conversion_kernel(const ConversionKernel kernel);
+ConversionKernel get_conversion_kernel(void);
+
 #endif
\ No newline at end of file
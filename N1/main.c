@@ -1,7 +1,72 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include "functions.h"
 
+#define DEFAULT_RADIX 4
+#define DEFAULT_THREADS 4
+#define DEFAULT_CHUNK_SIZE 65536
+#define READ_BUFFER_SIZE 65536
+
+typedef struct {
+    const char* input_path;
+    const char* output_path;
+    int binary;
+    int mapped;
+    int r;
+    int threads;
+    size_t chunk_size;
+} FileOptions;
+
+typedef struct {
+    FILE* file;
+    int binary;
+    char buffer[READ_BUFFER_SIZE];
+    size_t length;
+    size_t position;
+    int eof;
+} InputReader;
+
+typedef struct {
+    unsigned int* values;
+    size_t count;
+    char* output;
+    size_t output_length;
+    size_t* offsets;
+    int ready;
+    int done;
+    ConversionStatus status;
+} ChunkJob;
+
+typedef struct {
+    ChunkJob* jobs;
+    size_t window;
+    size_t next_to_convert;
+    size_t filled;
+    int r;
+    int finished;
+    pthread_mutex_t lock;
+    pthread_cond_t work_available;
+    pthread_cond_t work_done;
+} WorkerPool;
+
+typedef struct {
+    const unsigned int* values;
+    size_t begin;
+    size_t end;
+    int r;
+    size_t chunk_size;
+    char* output;
+    size_t output_length;
+    ConversionStatus status;
+} MappedSlice;
+
 void demo_conversion(unsigned int number, int r) {
     char* result = NULL;
     ConversionStatus status = convert_to_base(number, r, &result);
@@ -16,7 +81,7 @@ void demo_conversion(unsigned int number, int r) {
     }
 }
 
-int main() {
+static int run_demo(void) {
     unsigned int test_numbers[] = {0, 1, 15, 16, 255, 1024, 12345};
     int r_values[] = {1, 2, 3, 4, 5};
     
@@ -47,4 +112,566 @@ int main() {
     printf("convert_to_base(10, 2, NULL) -> status: %d\n", status);
     
     return 0;
+}
+
+static void print_usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s                run the conversion demonstration\n"
+            "       %s -i FILE [-o FILE] [-b] [-r R] [-t THREADS] [-c CHUNK]\n"
+            "       %s -m -b -i FILE -o FILE [-r R] [-t THREADS] [-c CHUNK]\n"
+            "  -i FILE     input integers, whitespace separated text\n"
+            "  -b          input is binary native-endian 32-bit unsigned integers\n"
+            "  -m          memory-map the binary (-b) input and a pre-sized output file\n"
+            "  -o FILE     output file, one converted value per line (default: stdout)\n"
+            "  -r R        convert to base 2^R, 1..5 (default %d)\n"
+            "  -t THREADS  worker threads (default %d)\n"
+            "  -c CHUNK    values per chunk (default %d)\n",
+            program, program, program, DEFAULT_RADIX, DEFAULT_THREADS, DEFAULT_CHUNK_SIZE);
+}
+
+static int fill_reader(InputReader* reader) {
+    if (reader->position < reader->length) {
+        memmove(reader->buffer, reader->buffer + reader->position, reader->length - reader->position);
+    }
+    reader->length -= reader->position;
+    reader->position = 0;
+
+    size_t read = fread(reader->buffer + reader->length, 1, READ_BUFFER_SIZE - reader->length, reader->file);
+    reader->length += read;
+    if (read == 0) {
+        reader->eof = 1;
+    }
+    return read > 0;
+}
+
+/* Returns the number of values read, or -1 on malformed input. */
+static long read_values(InputReader* reader, unsigned int* values, const size_t max_count) {
+    size_t count = 0;
+
+    if (reader->binary) {
+        const size_t bytes = fread(values, 1, max_count * sizeof(unsigned int), reader->file);
+        if (bytes % sizeof(unsigned int) != 0) {
+            return -1;
+        }
+        return (long)(bytes / sizeof(unsigned int));
+    }
+
+    while (count < max_count) {
+        if (reader->length - reader->position < 16 && !reader->eof) {
+            fill_reader(reader);
+        }
+        while (reader->position < reader->length &&
+               strchr(" \t\r\n", reader->buffer[reader->position]) != NULL) {
+            reader->position++;
+        }
+        if (reader->position == reader->length) {
+            if (reader->eof) {
+                break;
+            }
+            continue;
+        }
+        if (reader->length - reader->position < 16 && !reader->eof) {
+            fill_reader(reader);
+        }
+
+        unsigned long value = 0;
+        int digits = 0;
+        for (;;) {
+            while (reader->position < reader->length &&
+                   reader->buffer[reader->position] >= '0' && reader->buffer[reader->position] <= '9') {
+                value = value * 10 + (unsigned long)(reader->buffer[reader->position] - '0');
+                if (value > 4294967295ul) {
+                    return -1;
+                }
+                reader->position++;
+                digits++;
+            }
+            /* The token may continue past the buffered bytes; its digits are already folded into value. */
+            if (reader->position < reader->length || reader->eof) {
+                break;
+            }
+            fill_reader(reader);
+        }
+        if (digits == 0 || (reader->position < reader->length &&
+                            strchr(" \t\r\n", reader->buffer[reader->position]) == NULL)) {
+            return -1;
+        }
+        values[count++] = (unsigned int)value;
+    }
+
+    return (long)count;
+}
+
+static void convert_job(ChunkJob* job, const int r) {
+    job->status = convert_to_base_batch(job->values, job->count, r, job->output,
+                                        job->count * (size_t)(32 / r + 2), job->offsets, NULL);
+    if (job->status != CONVERSION_OK || job->count == 0) {
+        job->output_length = 0;
+        return;
+    }
+
+    for (size_t i = 1; i < job->count; i++) {
+        job->output[job->offsets[i] - 1] = '\n';
+    }
+    job->output_length = job->offsets[job->count - 1] +
+                         convert_to_base_length(job->values[job->count - 1], r) + 1;
+    job->output[job->output_length - 1] = '\n';
+}
+
+static void* worker_main(void* arg) {
+    WorkerPool* pool = (WorkerPool*)arg;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->next_to_convert == pool->filled && !pool->finished) {
+            pthread_cond_wait(&pool->work_available, &pool->lock);
+        }
+        if (pool->next_to_convert == pool->filled) {
+            break;
+        }
+
+        ChunkJob* job = &pool->jobs[pool->next_to_convert % pool->window];
+        pool->next_to_convert++;
+        pthread_mutex_unlock(&pool->lock);
+
+        convert_job(job, pool->r);
+
+        pthread_mutex_lock(&pool->lock);
+        job->done = 1;
+        pthread_cond_broadcast(&pool->work_done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
+
+/* Waits for the oldest outstanding chunk and writes it; returns 0 on error. */
+static int write_job(WorkerPool* pool, ChunkJob* job, FILE* output) {
+    pthread_mutex_lock(&pool->lock);
+    while (!job->done) {
+        pthread_cond_wait(&pool->work_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    job->ready = 0;
+    if (job->status != CONVERSION_OK) {
+        fprintf(stderr, "Error: conversion failed with status code %d\n", job->status);
+        return 0;
+    }
+    return fwrite(job->output, 1, job->output_length, output) == job->output_length;
+}
+
+static double seconds_since(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)(now.tv_sec - start->tv_sec) + (double)(now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+static int run_pipeline(const FileOptions* options, InputReader* reader, FILE* output) {
+    WorkerPool pool;
+    pool.window = (size_t)options->threads * 2;
+    pool.next_to_convert = 0;
+    pool.filled = 0;
+    pool.r = options->r;
+    pool.finished = 0;
+    pool.jobs = (ChunkJob*)calloc(pool.window, sizeof(ChunkJob));
+    if (pool.jobs == NULL) {
+        fprintf(stderr, "Error: cannot allocate chunk table\n");
+        return 1;
+    }
+
+    const size_t max_output = options->chunk_size * (size_t)(32 / options->r + 2);
+    int failed = 0;
+    for (size_t i = 0; i < pool.window; i++) {
+        pool.jobs[i].values = (unsigned int*)malloc(options->chunk_size * sizeof(unsigned int));
+        pool.jobs[i].offsets = (size_t*)malloc(options->chunk_size * sizeof(size_t));
+        pool.jobs[i].output = (char*)malloc(max_output);
+        if (pool.jobs[i].values == NULL || pool.jobs[i].offsets == NULL || pool.jobs[i].output == NULL) {
+            failed = 1;
+        }
+    }
+
+    pthread_t* threads = (pthread_t*)malloc((size_t)options->threads * sizeof(pthread_t));
+    int started = 0;
+    if (!failed && threads != NULL) {
+        pthread_mutex_init(&pool.lock, NULL);
+        pthread_cond_init(&pool.work_available, NULL);
+        pthread_cond_init(&pool.work_done, NULL);
+        while (started < options->threads &&
+               pthread_create(&threads[started], NULL, worker_main, &pool) == 0) {
+            started++;
+        }
+    }
+    if (failed || started == 0) {
+        fprintf(stderr, "Error: cannot start worker pool\n");
+        failed = 1;
+    }
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    size_t total = 0;
+    size_t written = 0;
+
+    while (!failed) {
+        ChunkJob* job = &pool.jobs[pool.filled % pool.window];
+        if (job->ready) {
+            if (!write_job(&pool, job, output)) {
+                failed = 1;
+                break;
+            }
+            written++;
+        }
+
+        long count = read_values(reader, job->values, options->chunk_size);
+        if (count < 0) {
+            fprintf(stderr, "Error: malformed input near value %zu\n", total);
+            failed = 1;
+            break;
+        }
+        if (count == 0) {
+            break;
+        }
+
+        pthread_mutex_lock(&pool.lock);
+        job->count = (size_t)count;
+        job->ready = 1;
+        job->done = 0;
+        pool.filled++;
+        pthread_cond_signal(&pool.work_available);
+        pthread_mutex_unlock(&pool.lock);
+        total += (size_t)count;
+    }
+
+    /* Nothing past a failed chunk is written; the workers are only joined. */
+    while (!failed && written < pool.filled) {
+        ChunkJob* job = &pool.jobs[written % pool.window];
+        if (job->ready && !write_job(&pool, job, output)) {
+            failed = 1;
+        }
+        written++;
+    }
+
+    if (started > 0) {
+        pthread_mutex_lock(&pool.lock);
+        pool.finished = 1;
+        pthread_cond_broadcast(&pool.work_available);
+        pthread_mutex_unlock(&pool.lock);
+        for (int i = 0; i < started; i++) {
+            pthread_join(threads[i], NULL);
+        }
+        pthread_mutex_destroy(&pool.lock);
+        pthread_cond_destroy(&pool.work_available);
+        pthread_cond_destroy(&pool.work_done);
+    }
+
+    double elapsed = seconds_since(&start);
+    if (!failed) {
+        fprintf(stderr, "Converted %zu values in %.3f s (%.0f values/s) with %d threads, chunk %zu\n",
+                total, elapsed, elapsed > 0.0 ? (double)total / elapsed : 0.0,
+                started, options->chunk_size);
+    }
+
+    for (size_t i = 0; i < pool.window; i++) {
+        free(pool.jobs[i].values);
+        free(pool.jobs[i].offsets);
+        free(pool.jobs[i].output);
+    }
+    free(pool.jobs);
+    free(threads);
+
+    return failed;
+}
+
+static int run_file_conversion(const FileOptions* options) {
+    InputReader* reader = (InputReader*)malloc(sizeof(InputReader));
+    if (reader == NULL) {
+        fprintf(stderr, "Error: cannot allocate input buffer\n");
+        return 1;
+    }
+    reader->file = fopen(options->input_path, options->binary ? "rb" : "r");
+    reader->binary = options->binary;
+    reader->length = 0;
+    reader->position = 0;
+    reader->eof = 0;
+    if (reader->file == NULL) {
+        fprintf(stderr, "Error: cannot open input file '%s'\n", options->input_path);
+        free(reader);
+        return 1;
+    }
+
+    FILE* output = stdout;
+    if (options->output_path != NULL) {
+        output = fopen(options->output_path, "wb");
+        if (output == NULL) {
+            fprintf(stderr, "Error: cannot open output file '%s'\n", options->output_path);
+            fclose(reader->file);
+            free(reader);
+            return 1;
+        }
+    }
+
+    int failed = run_pipeline(options, reader, output);
+
+    if (output != stdout && fclose(output) != 0) {
+        failed = 1;
+    }
+    fclose(reader->file);
+    free(reader);
+    return failed;
+}
+
+static void* size_slice(void* arg) {
+    MappedSlice* slice = (MappedSlice*)arg;
+    size_t length = 0;
+
+    for (size_t i = slice->begin; i < slice->end; i++) {
+        length += convert_to_base_length(slice->values[i], slice->r) + 1;
+    }
+    slice->output_length = length;
+    return NULL;
+}
+
+/*
+ * Each slice owns the exact byte range sized by size_slice, so the batch
+ * converter writes straight into the mapping; the terminators it leaves
+ * after every value are overwritten with newlines.
+ */
+static void* write_slice(void* arg) {
+    MappedSlice* slice = (MappedSlice*)arg;
+    size_t* offsets = (size_t*)malloc(slice->chunk_size * sizeof(size_t));
+    if (offsets == NULL) {
+        slice->status = CONVERSION_MEMORY_ERROR;
+        return NULL;
+    }
+
+    char* out = slice->output;
+    size_t remaining = slice->output_length;
+    slice->status = CONVERSION_OK;
+    for (size_t i = slice->begin; i < slice->end && slice->status == CONVERSION_OK; ) {
+        size_t count = slice->end - i;
+        if (count > slice->chunk_size) {
+            count = slice->chunk_size;
+        }
+
+        slice->status = convert_to_base_batch(slice->values + i, count, slice->r,
+                                              out, remaining, offsets, NULL);
+        if (slice->status == CONVERSION_OK) {
+            for (size_t k = 1; k < count; k++) {
+                out[offsets[k] - 1] = '\n';
+            }
+            size_t length = offsets[count - 1] + convert_to_base_length(slice->values[i + count - 1], slice->r) + 1;
+            out[length - 1] = '\n';
+            out += length;
+            remaining -= length;
+        }
+        i += count;
+    }
+
+    free(offsets);
+    return NULL;
+}
+
+/* Runs one pass over all slices, falling back to the calling thread if a worker cannot start. */
+static void run_slices(MappedSlice* slices, const int count, void* (*pass)(void*)) {
+    pthread_t threads[256];
+    int started[256];
+
+    for (int i = 0; i < count; i++) {
+        started[i] = pthread_create(&threads[i], NULL, pass, &slices[i]) == 0;
+        if (!started[i]) {
+            pass(&slices[i]);
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+}
+
+static int run_mapped_conversion(const FileOptions* options) {
+    int input = open(options->input_path, O_RDONLY);
+    if (input < 0) {
+        fprintf(stderr, "Error: cannot open input file '%s'\n", options->input_path);
+        return 1;
+    }
+
+    struct stat input_stat;
+    if (fstat(input, &input_stat) != 0 || input_stat.st_size % (off_t)sizeof(unsigned int) != 0) {
+        fprintf(stderr, "Error: input file '%s' is not a whole number of 32-bit values\n", options->input_path);
+        close(input);
+        return 1;
+    }
+
+    const size_t total = (size_t)input_stat.st_size / sizeof(unsigned int);
+    const unsigned int* values = NULL;
+    if (total > 0) {
+        void* mapping = mmap(NULL, (size_t)input_stat.st_size, PROT_READ, MAP_PRIVATE, input, 0);
+        if (mapping == MAP_FAILED) {
+            fprintf(stderr, "Error: cannot map input file '%s'\n", options->input_path);
+            close(input);
+            return 1;
+        }
+        posix_madvise(mapping, (size_t)input_stat.st_size, POSIX_MADV_SEQUENTIAL);
+        values = (const unsigned int*)mapping;
+    }
+    close(input);
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    int slice_count = options->threads;
+    if ((size_t)slice_count > total) {
+        slice_count = total > 0 ? (int)total : 1;
+    }
+    MappedSlice slices[256];
+    for (int i = 0; i < slice_count; i++) {
+        slices[i].values = values;
+        slices[i].begin = total * (size_t)i / (size_t)slice_count;
+        slices[i].end = total * (size_t)(i + 1) / (size_t)slice_count;
+        slices[i].r = options->r;
+        slices[i].chunk_size = options->chunk_size;
+        slices[i].output = NULL;
+        slices[i].status = CONVERSION_OK;
+    }
+    run_slices(slices, slice_count, size_slice);
+
+    size_t output_size = 0;
+    for (int i = 0; i < slice_count; i++) {
+        output_size += slices[i].output_length;
+    }
+
+    int failed = 0;
+    int output = open(options->output_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    char* mapped_output = NULL;
+    if (output < 0 || ftruncate(output, (off_t)output_size) != 0) {
+        fprintf(stderr, "Error: cannot create output file '%s'\n", options->output_path);
+        failed = 1;
+    } else if (output_size > 0) {
+        void* mapping = mmap(NULL, output_size, PROT_READ | PROT_WRITE, MAP_SHARED, output, 0);
+        if (mapping == MAP_FAILED) {
+            fprintf(stderr, "Error: cannot map output file '%s'\n", options->output_path);
+            failed = 1;
+        } else {
+            mapped_output = (char*)mapping;
+        }
+    }
+
+    if (mapped_output != NULL) {
+        size_t offset = 0;
+        for (int i = 0; i < slice_count; i++) {
+            slices[i].output = mapped_output + offset;
+            offset += slices[i].output_length;
+        }
+        run_slices(slices, slice_count, write_slice);
+        for (int i = 0; i < slice_count; i++) {
+            if (slices[i].status != CONVERSION_OK) {
+                fprintf(stderr, "Error: conversion failed with status code %d\n", slices[i].status);
+                failed = 1;
+                break;
+            }
+        }
+        munmap(mapped_output, output_size);
+    }
+
+    double elapsed = seconds_since(&start);
+    if (!failed) {
+        fprintf(stderr, "Converted %zu values in %.3f s (%.0f values/s) with %d threads, mapped output %zu bytes\n",
+                total, elapsed, elapsed > 0.0 ? (double)total / elapsed : 0.0, slice_count, output_size);
+    }
+
+    if (output >= 0 && close(output) != 0) {
+        failed = 1;
+    }
+    if (values != NULL) {
+        munmap((void*)values, (size_t)input_stat.st_size);
+    }
+    return failed;
+}
+
+static int parse_positive(const char* text, long max, long* value) {
+    char* end = NULL;
+    long parsed = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || parsed < 1 || parsed > max) {
+        return 0;
+    }
+    *value = parsed;
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc == 1) {
+        return run_demo();
+    }
+
+    FileOptions options;
+    options.input_path = NULL;
+    options.output_path = NULL;
+    options.binary = 0;
+    options.mapped = 0;
+    options.r = DEFAULT_RADIX;
+    options.threads = DEFAULT_THREADS;
+    options.chunk_size = DEFAULT_CHUNK_SIZE;
+
+    int option;
+    long value;
+    while ((option = getopt(argc, argv, "i:o:bmr:t:c:h")) != -1) {
+        switch (option) {
+            case 'i':
+                options.input_path = optarg;
+                break;
+            case 'o':
+                options.output_path = optarg;
+                break;
+            case 'b':
+                options.binary = 1;
+                break;
+            case 'm':
+                options.mapped = 1;
+                break;
+            case 'r':
+                if (!parse_positive(optarg, 5, &value)) {
+                    fprintf(stderr, "Error: radix exponent must be 1..5\n");
+                    return 1;
+                }
+                options.r = (int)value;
+                break;
+            case 't':
+                if (!parse_positive(optarg, 256, &value)) {
+                    fprintf(stderr, "Error: thread count must be 1..256\n");
+                    return 1;
+                }
+                options.threads = (int)value;
+                break;
+            case 'c':
+                if (!parse_positive(optarg, 1L << 24, &value)) {
+                    fprintf(stderr, "Error: chunk size must be 1..%ld\n", 1L << 24);
+                    return 1;
+                }
+                options.chunk_size = (size_t)value;
+                break;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    if (options.input_path == NULL || optind != argc) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (options.mapped) {
+        if (options.output_path == NULL) {
+            fprintf(stderr, "Error: -m requires an output file\n");
+            return 1;
+        }
+        if (!options.binary) {
+            fprintf(stderr, "Error: -m requires binary input (-b)\n");
+            return 1;
+        }
+        return run_mapped_conversion(&options);
+    }
+
+    return run_file_conversion(&options);
 }
\ No newline at end of file
@@ -82,6 +82,435 @@ int test_null_pointer() {
     return status == CONVERSION_NULL_POINTER;
 }
 
+int test_batch() {
+    unsigned int values[] = {0, 10, 255, 1024, 4294967295u};
+    size_t offsets[5];
+    ConversionStatus statuses[5];
+    char buffer[64];
+
+    ConversionStatus status = convert_to_base_batch(values, 5, 4, buffer, sizeof(buffer),
+                                                    offsets, statuses);
+    if (status != CONVERSION_OK) {
+        return 0;
+    }
+
+    const char* expected[] = {"0", "A", "FF", "400", "FFFFFFFF"};
+    for (int i = 0; i < 5; i++) {
+        if (statuses[i] != CONVERSION_OK || strcmp(buffer + offsets[i], expected[i]) != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int test_batch_buffer_too_small() {
+    unsigned int values[] = {1, 4294967295u, 2};
+    size_t offsets[3];
+    ConversionStatus statuses[3];
+    char buffer[8];
+
+    ConversionStatus status = convert_to_base_batch(values, 3, 1, buffer, sizeof(buffer),
+                                                    offsets, statuses);
+    return status == CONVERSION_MEMORY_ERROR &&
+           statuses[0] == CONVERSION_OK && strcmp(buffer + offsets[0], "1") == 0 &&
+           statuses[1] == CONVERSION_MEMORY_ERROR && offsets[1] == CONVERSION_NO_OFFSET &&
+           statuses[2] == CONVERSION_OK && strcmp(buffer + offsets[2], "10") == 0;
+}
+
+int test_batch_errors() {
+    unsigned int values[] = {1};
+    size_t offsets[1];
+    char buffer[8];
+
+    return convert_to_base_batch(values, 1, 6, buffer, sizeof(buffer), offsets, NULL) == CONVERSION_INVALID_BASE &&
+           convert_to_base_batch(NULL, 1, 2, buffer, sizeof(buffer), offsets, NULL) == CONVERSION_NULL_POINTER &&
+           convert_to_base_batch(values, 1, 2, NULL, 0, offsets, NULL) == CONVERSION_NULL_POINTER &&
+           convert_to_base_batch(values, 1, 2, buffer, sizeof(buffer), NULL, NULL) == CONVERSION_NULL_POINTER;
+}
+
+int test_kernels_agree() {
+    const ConversionKernel kernels[] = {CONVERSION_KERNEL_SSE2, CONVERSION_KERNEL_AVX2,
+                                        CONVERSION_KERNEL_AUTO};
+    unsigned int values[] = {0, 1, 7, 8, 31, 32, 255, 256, 65535, 123456789u,
+                             2147483648u, 4294967294u, 4294967295u};
+    int success = 1;
+
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+            for (int r = 1; r <= 5; r++) {
+                char* expected = NULL;
+                char* actual = NULL;
+                set_conversion_kernel(CONVERSION_KERNEL_SCALAR);
+                convert_to_base(values[i], r, &expected);
+                set_conversion_kernel(kernels[k]);
+                convert_to_base(values[i], r, &actual);
+                if (expected == NULL || actual == NULL || strcmp(expected, actual) != 0) {
+                    success = 0;
+                }
+                free(expected);
+                free(actual);
+            }
+        }
+    }
+
+    set_conversion_kernel(CONVERSION_KERNEL_AUTO);
+    return success;
+}
+
+int test_u64() {
+    struct {
+        uint64_t value;
+        int r;
+        const char* expected;
+    } cases[] = {
+        {0, 3, "0"},
+        {4294967296ull, 4, "100000000"},
+        {18446744073709551615ull, 4, "FFFFFFFFFFFFFFFF"},
+        {18446744073709551615ull, 5, "FVVVVVVVVVVVV"},
+        {18446744073709551615ull, 3, "1777777777777777777777"},
+        {1099511627776ull, 1, "10000000000000000000000000000000000000000"}
+    };
+    int success = 1;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        char* result = NULL;
+        ConversionStatus status = convert_to_base_u64(cases[i].value, cases[i].r, &result);
+        if (status != CONVERSION_OK || strcmp(result, cases[i].expected) != 0) {
+            success = 0;
+        }
+        free(result);
+    }
+
+    return success && convert_to_base_u64(1, 0, NULL) == CONVERSION_NULL_POINTER;
+}
+
+int test_bytes() {
+    unsigned char key[16];
+    for (int i = 0; i < 16; i++) {
+        key[i] = (unsigned char)i;
+    }
+    char buffer[160];
+    size_t written = 0;
+
+    ConversionStatus status = convert_bytes_to_base(key, 16, 4, buffer, sizeof(buffer), &written);
+    if (status != CONVERSION_OK || strcmp(buffer, "F0E0D0C0B0A09080706050403020100") != 0 ||
+        written != 31) {
+        return 0;
+    }
+
+    unsigned char zeros[3] = {0, 0, 0};
+    status = convert_bytes_to_base(zeros, 3, 5, buffer, sizeof(buffer), &written);
+    if (status != CONVERSION_OK || strcmp(buffer, "0") != 0) {
+        return 0;
+    }
+
+    status = convert_bytes_to_base(key, 16, 1, buffer, 8, &written);
+    return status == CONVERSION_MEMORY_ERROR && written == 124;
+}
+
+int test_bytes_match_u64() {
+    uint64_t state = 88172645463325252ull;
+    int success = 1;
+
+    for (int i = 0; i < 200; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        uint64_t value = state >> (i % 64);
+
+        unsigned char bytes[8];
+        for (int b = 0; b < 8; b++) {
+            bytes[b] = (unsigned char)(value >> (8 * b));
+        }
+
+        for (int r = 1; r <= 5; r++) {
+            char* expected = NULL;
+            char buffer[72];
+            size_t written = 0;
+            convert_to_base_u64(value, r, &expected);
+            ConversionStatus status = convert_bytes_to_base(bytes, 8, r, buffer, sizeof(buffer), &written);
+            if (status != CONVERSION_OK || expected == NULL || strcmp(expected, buffer) != 0 ||
+                written != strlen(expected)) {
+                success = 0;
+            }
+            free(expected);
+        }
+    }
+
+    return success;
+}
+
+int test_decode_round_trip() {
+    const ConversionKernel kernels[] = {CONVERSION_KERNEL_SCALAR, CONVERSION_KERNEL_SSE2,
+                                        CONVERSION_KERNEL_AVX2, CONVERSION_KERNEL_AUTO};
+    unsigned int values[] = {0, 1, 31, 32, 1024, 12345, 2147483648u, 4294967295u};
+    int success = 1;
+
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        set_conversion_kernel(kernels[k]);
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+            for (int r = 1; r <= 5; r++) {
+                char* encoded = NULL;
+                unsigned int decoded = 1;
+                convert_to_base(values[i], r, &encoded);
+                if (encoded == NULL || convert_from_base(encoded, r, &decoded) != CONVERSION_OK ||
+                    decoded != values[i]) {
+                    success = 0;
+                }
+                free(encoded);
+            }
+        }
+    }
+
+    set_conversion_kernel(CONVERSION_KERNEL_AUTO);
+    return success;
+}
+
+int test_decode_page_boundary() {
+    const ConversionKernel kernels[] = {CONVERSION_KERNEL_SCALAR, CONVERSION_KERNEL_SSE2,
+                                        CONVERSION_KERNEL_AVX2, CONVERSION_KERNEL_AUTO};
+    char* block = (char*)malloc(3 * 4096);
+    if (block == NULL) {
+        return 0;
+    }
+    memset(block, 'Z', 3 * 4096);
+    char* page = block + 4096 - (size_t)((uintptr_t)block % 4096) + 4096;
+    const char* encoded[] = {"7FFFFFFF", "11111111111111111111111111111111"};
+    const int radices[] = {4, 1};
+    const unsigned int expected[] = {2147483647u, 4294967295u};
+    int success = 1;
+
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        set_conversion_kernel(kernels[k]);
+        for (int e = 0; e < 2; e++) {
+            const size_t length = strlen(encoded[e]);
+            for (size_t shift = length + 1; shift <= 48; shift++) {
+                char* text = page - shift;
+                unsigned int value = 0;
+                memcpy(text, encoded[e], length + 1);
+                success &= convert_from_base(text, radices[e], &value) == CONVERSION_OK && value == expected[e];
+                memset(text, 'Z', length + 1);
+            }
+        }
+    }
+
+    set_conversion_kernel(CONVERSION_KERNEL_AUTO);
+    free(block);
+    return success;
+}
+
+int test_decode_errors() {
+    const ConversionKernel kernels[] = {CONVERSION_KERNEL_SCALAR, CONVERSION_KERNEL_SSE2,
+                                        CONVERSION_KERNEL_AVX2};
+    int success = 1;
+    unsigned int value = 0;
+
+    for (size_t k = 0; k < sizeof(kernels) / sizeof(kernels[0]); k++) {
+        set_conversion_kernel(kernels[k]);
+        success &= convert_from_base("0000000000000000000000000FFFFFFFF", 4, &value) == CONVERSION_OK &&
+                   value == 4294967295u;
+        success &= convert_from_base("100000000", 4, &value) == CONVERSION_OVERFLOW;
+        success &= convert_from_base("FG", 4, &value) == CONVERSION_INVALID_DIGIT;
+        success &= convert_from_base("ff", 4, &value) == CONVERSION_INVALID_DIGIT;
+        success &= convert_from_base("1:", 5, &value) == CONVERSION_INVALID_DIGIT;
+        success &= convert_from_base("1@", 5, &value) == CONVERSION_INVALID_DIGIT;
+        success &= convert_from_base("12", 1, &value) == CONVERSION_INVALID_DIGIT;
+        success &= convert_from_base("7 ", 3, &value) == CONVERSION_INVALID_DIGIT;
+        success &= convert_from_base("1\xC0", 5, &value) == CONVERSION_INVALID_DIGIT;
+        success &= convert_from_base("", 2, &value) == CONVERSION_INVALID_DIGIT;
+        success &= convert_from_base("VV", 5, &value) == CONVERSION_OK && value == 1023;
+    }
+
+    set_conversion_kernel(CONVERSION_KERNEL_AUTO);
+    return success &&
+           convert_from_base("1", 6, &value) == CONVERSION_INVALID_BASE &&
+           convert_from_base(NULL, 2, &value) == CONVERSION_NULL_POINTER &&
+           convert_from_base("1", 2, NULL) == CONVERSION_NULL_POINTER;
+}
+
+int test_decode_batch() {
+    const char* strings[] = {"1010", "0", "102", "11111111111111111111111111111111"};
+    unsigned int values[4];
+    ConversionStatus statuses[4];
+
+    ConversionStatus status = convert_from_base_batch(strings, 4, 1, values, statuses);
+    return status == CONVERSION_INVALID_DIGIT &&
+           statuses[0] == CONVERSION_OK && values[0] == 10 &&
+           statuses[1] == CONVERSION_OK && values[1] == 0 &&
+           statuses[2] == CONVERSION_INVALID_DIGIT && values[2] == 0 &&
+           statuses[3] == CONVERSION_OK && values[3] == 4294967295u;
+}
+
+int test_length() {
+    unsigned int values[] = {0, 1, 2, 3, 7, 8, 31, 32, 1023, 1024, 65535, 65536,
+                             2147483647u, 2147483648u, 4294967295u};
+    int success = 1;
+
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        for (int r = 1; r <= 5; r++) {
+            char* result = NULL;
+            convert_to_base(values[i], r, &result);
+            if (result == NULL || convert_to_base_length(values[i], r) != strlen(result) ||
+                convert_to_base_length_u64(values[i], r) != strlen(result)) {
+                success = 0;
+            }
+            free(result);
+        }
+    }
+
+    return success &&
+           convert_to_base_length_u64(18446744073709551615ull, 1) == 64 &&
+           convert_to_base_length_u64(18446744073709551615ull, 5) == 13 &&
+           convert_to_base_length(10, 0) == 0 &&
+           convert_to_base_length(10, 6) == 0;
+}
+
+int test_fixed_radix() {
+    ConversionStatus (*converters[])(const unsigned int, char**) = {
+        convert_to_base_r1, convert_to_base_r2, convert_to_base_r3,
+        convert_to_base_r4, convert_to_base_r5
+    };
+    unsigned int values[] = {0, 1, 10, 255, 1024, 12345, 4294967295u};
+    int success = 1;
+
+    for (int r = 1; r <= 5; r++) {
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+            char* expected = NULL;
+            char* actual = NULL;
+            set_conversion_kernel(CONVERSION_KERNEL_SCALAR);
+            convert_to_base(values[i], r, &expected);
+            set_conversion_kernel(CONVERSION_KERNEL_AUTO);
+            ConversionStatus status = converters[r - 1](values[i], &actual);
+            if (status != CONVERSION_OK || expected == NULL || strcmp(expected, actual) != 0) {
+                success = 0;
+            }
+            free(expected);
+            free(actual);
+        }
+        if (converters[r - 1](1, NULL) != CONVERSION_NULL_POINTER) {
+            success = 0;
+        }
+    }
+
+    return success;
+}
+
+static void reference_convert(unsigned int n, const int r, char* out) {
+    const char* alphabet = "0123456789ABCDEFGHIJKLMNOPQRSTUV";
+    char digits[33];
+    int length = 0;
+    do {
+        digits[length++] = alphabet[n & ((1u << r) - 1)];
+        n = n >> r;
+    } while (n != 0);
+    for (int i = 0; i < length; i++) {
+        out[i] = digits[length - 1 - i];
+    }
+    out[length] = '\0';
+}
+
+int test_lookup_tables() {
+    int success = 1;
+    set_conversion_kernel(CONVERSION_KERNEL_SCALAR);
+
+    for (int bit = 0; bit < 32; bit++) {
+        const unsigned int power = 1u << bit;
+        const unsigned int values[] = {power - 1, power, power + 1, power | (power - 1) / 3};
+        for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+            for (int r = 1; r <= 5; r++) {
+                char expected[33];
+                char* actual = NULL;
+                reference_convert(values[i], r, expected);
+                if (convert_to_base(values[i], r, &actual) != CONVERSION_OK ||
+                    strcmp(expected, actual) != 0) {
+                    success = 0;
+                }
+                free(actual);
+            }
+        }
+    }
+
+    set_conversion_kernel(CONVERSION_KERNEL_AUTO);
+    return success;
+}
+
+int test_formatted() {
+    struct {
+        unsigned int value;
+        int r;
+        ConversionFormat format;
+        const char* expected;
+    } cases[] = {
+        {0xABu, 4, {8, 0, '\0', 0}, "000000AB"},
+        {0xABu, 4, {8, 0, '\0', 1}, "000000ab"},
+        {0xDEADBEEFu, 4, {0, 4, ':', 1}, "dead:beef"},
+        {0x1Fu, 1, {8, 4, '_', 0}, "0001_1111"},
+        {31u, 5, {4, 2, ' ', 1}, "00 0v"},
+        {4294967295u, 5, {2, 0, '\0', 0}, "3VVVVVV"},
+        {0u, 3, {0, 3, ',', 0}, "0"}
+    };
+    int success = 1;
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        char buffer[64];
+        size_t written = 0;
+        ConversionStatus status = convert_to_base_formatted(cases[i].value, cases[i].r, &cases[i].format,
+                                                            buffer, sizeof(buffer), &written);
+        if (status != CONVERSION_OK || strcmp(buffer, cases[i].expected) != 0 ||
+            written != strlen(cases[i].expected) ||
+            convert_to_base_formatted_length(cases[i].value, cases[i].r, &cases[i].format) != written) {
+            success = 0;
+        }
+    }
+
+    char small[8];
+    size_t written = 0;
+    ConversionFormat padded = {8, 0, '\0', 0};
+    if (convert_to_base_formatted(1u, 4, &padded, small, sizeof(small), &written) != CONVERSION_MEMORY_ERROR ||
+        written != 8) {
+        success = 0;
+    }
+    if (convert_to_base_formatted(255u, 1, NULL, small, sizeof(small), &written) != CONVERSION_MEMORY_ERROR ||
+        convert_to_base_formatted(1u, 6, NULL, small, sizeof(small), &written) != CONVERSION_INVALID_BASE) {
+        success = 0;
+    }
+
+    return success;
+}
+
+int test_arena() {
+    ConversionArena arena;
+    if (conversion_arena_init(&arena, 16) != CONVERSION_OK) {
+        return 0;
+    }
+
+    char* first = NULL;
+    char* second = NULL;
+    char* overflow = NULL;
+    int success = convert_to_base_arena(255, 4, &arena, &first) == CONVERSION_OK &&
+                  convert_to_base_arena(10, 1, &arena, &second) == CONVERSION_OK &&
+                  strcmp(first, "FF") == 0 && strcmp(second, "1010") == 0 &&
+                  arena.used == 8 && arena.high_water == 8;
+
+    if (convert_to_base_arena(4294967295u, 1, &arena, &overflow) != CONVERSION_MEMORY_ERROR ||
+        overflow != NULL || arena.used != 8 || arena.high_water != 41) {
+        success = 0;
+    }
+
+    conversion_arena_reset(&arena);
+    if (convert_to_base_arena(12345, 3, &arena, &first) != CONVERSION_OK ||
+        first != arena.base || strcmp(first, "30071") != 0 || arena.high_water != 41) {
+        success = 0;
+    }
+    if (convert_to_base_arena(1, 0, &arena, &first) != CONVERSION_INVALID_BASE ||
+        convert_to_base_arena(1, 4, NULL, &first) != CONVERSION_NULL_POINTER) {
+        success = 0;
+    }
+
+    conversion_arena_destroy(&arena);
+    return success && arena.base == NULL && arena.high_water == 0 && arena.capacity == 0;
+}
+
 int main() {
     printf("Running tests:\n\n");
     
@@ -93,6 +522,22 @@ int main() {
     run_test("Base 32", test_base_32);
     run_test("Invalid r parameter", test_invalid_r);
     run_test("NULL pointer", test_null_pointer);
+    run_test("Batch conversion", test_batch);
+    run_test("Batch buffer too small", test_batch_buffer_too_small);
+    run_test("Batch error handling", test_batch_errors);
+    run_test("SIMD kernels match scalar", test_kernels_agree);
+    run_test("64-bit conversion", test_u64);
+    run_test("Byte array conversion", test_bytes);
+    run_test("Byte array matches 64-bit", test_bytes_match_u64);
+    run_test("Decode round trip", test_decode_round_trip);
+    run_test("Decode error handling", test_decode_errors);
+    run_test("Decode across page boundary", test_decode_page_boundary);
+    run_test("Decode batch", test_decode_batch);
+    run_test("Digit count query", test_length);
+    run_test("Fixed radix converters", test_fixed_radix);
+    run_test("Lookup table digits", test_lookup_tables);
+    run_test("Formatted output", test_formatted);
+    run_test("Arena conversion", test_arena);
     
     printf("\nTest results:\n");
     printf("Passed: %d\n", tests_passed);
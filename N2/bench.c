@@ -0,0 +1,259 @@
+#include <stdio.h>
+#include <time.h>
+#include "functions.h"
+
+#define BENCH_VECTORS 1000000
+#define BENCH_ROUNDS 5
+#define SEARCH_ELEMENTS 1000000
+#define SEARCH_REPEATS 20
+#define CHURN_VECTORS 200000
+#define POOL_MAX_CACHED 64
+
+/*
+ * The bench target links with --wrap for the allocator entry points so the
+ * churn benchmark can report how many allocations reach the system allocator.
+ */
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* pointer, size_t size);
+
+static size_t allocation_count = 0;
+
+void* __wrap_malloc(size_t size) {
+    allocation_count++;
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    allocation_count++;
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* pointer, size_t size) {
+    allocation_count++;
+    return __real_realloc(pointer, size);
+}
+
+DECLARE_VECTOR(FloatVector, float_vector, float)
+DEFINE_VECTOR(FloatVector, float_vector, float)
+
+typedef enum {
+    SEARCH_FIND,
+    SEARCH_COUNT,
+    SEARCH_EQUAL
+} SearchOperation;
+
+static const char* const search_names[] = {"find", "count", "is_equal"};
+
+static double elapsed_ns(const struct timespec* start, const struct timespec* end) {
+    return (double)(end->tv_sec - start->tv_sec) * 1e9 + (double)(end->tv_nsec - start->tv_nsec);
+}
+
+/* Builds, reads back and destroys BENCH_VECTORS vectors of up to max_size ints. */
+static double time_small_vectors(const int use_inline, const size_t max_size, long* checksum) {
+    double best = 0.0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        struct timespec start, end;
+        long sum = 0;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int n = 0; n < BENCH_VECTORS; n++) {
+            SmallVector small;
+            Vector heap;
+            Vector* vec = use_inline ? &small.vector : &heap;
+            if (use_inline) {
+                create_small_vector(&small, NULL, NULL);
+            } else {
+                create_vector(&heap, 0, NULL, NULL);
+            }
+            const size_t size = (size_t)n % max_size + 1;
+            for (size_t i = 0; i < size; i++) {
+                push_back_vector(vec, (int)i + n);
+            }
+            for (size_t i = 0; i < vec->size; i++) {
+                int value;
+                get_at_vector(vec, i, &value);
+                sum += value;
+            }
+            delete_vector(vec);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double ns = elapsed_ns(&start, &end) / BENCH_VECTORS;
+        if (round == 0 || ns < best) {
+            best = ns;
+        }
+        *checksum = sum;
+    }
+    return best;
+}
+
+/*
+ * Creates, fills and deletes CHURN_VECTORS short-lived vectors of 1..max_size
+ * ints through allocator (NULL for malloc). Reports system allocations per vector.
+ */
+static double time_churn(const VectorAllocator* allocator, const size_t max_size, long* checksum,
+                         double* allocations) {
+    double best = 0.0;
+    const size_t allocations_before = allocation_count;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        struct timespec start, end;
+        long sum = 0;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int n = 0; n < CHURN_VECTORS; n++) {
+            Vector vec;
+            create_with_allocator_vector(&vec, 0, NULL, NULL, allocator);
+            const size_t size = (size_t)n * 7919 % max_size + 1;
+            for (size_t i = 0; i < size; i++) {
+                push_back_vector(&vec, (int)i);
+            }
+            sum += vec.data[size - 1];
+            delete_vector(&vec);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double ns = elapsed_ns(&start, &end) / CHURN_VECTORS;
+        if (round == 0 || ns < best) {
+            best = ns;
+        }
+        *checksum = sum;
+    }
+    *allocations = (double)(allocation_count - allocations_before) / ((double)BENCH_ROUNDS * CHURN_VECTORS);
+    return best;
+}
+
+static void bench_churn(void) {
+    const size_t sizes[] = {16, 64, 256, 1024};
+
+    printf("\nVector churn: create, push, delete (%d vectors)\n", CHURN_VECTORS);
+    printf("%-9s %13s %13s %9s %14s %14s\n", "elements", "malloc ns/vec", "pool ns/vec", "speedup",
+           "malloc allocs", "pool allocs");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        VectorPool pool;
+        vector_pool_init(&pool, POOL_MAX_CACHED);
+        const VectorAllocator allocator = vector_pool_allocator(&pool);
+        long malloc_sum = 0;
+        long pool_sum = 0;
+        double malloc_allocations = 0.0;
+        double pool_allocations = 0.0;
+        double malloc_ns = time_churn(NULL, sizes[s], &malloc_sum, &malloc_allocations);
+        double pool_ns = time_churn(&allocator, sizes[s], &pool_sum, &pool_allocations);
+        printf("1..%-6zu %13.2f %13.2f %8.2fx %14.3f %14.3f%s\n", sizes[s], malloc_ns, pool_ns,
+               malloc_ns / pool_ns, malloc_allocations, pool_allocations, malloc_sum == pool_sum ? "" : "  MISMATCH");
+        vector_pool_destroy(&pool);
+    }
+}
+
+/* Microseconds per call over a full scan: find looks for a missing value. */
+static double time_int_search(const Vector* a, const Vector* b, const SearchOperation operation, size_t* result) {
+    double best = 0.0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        struct timespec start, end;
+        size_t total = 0;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int repeat = 0; repeat < SEARCH_REPEATS; repeat++) {
+            size_t value = 0;
+            switch (operation) {
+                case SEARCH_FIND: find_vector(a, -1, &value); break;
+                case SEARCH_COUNT: count_vector(a, 7, &value); break;
+                default: value = (size_t)is_equal_vector(a, b); break;
+            }
+            total += value;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double us = elapsed_ns(&start, &end) / SEARCH_REPEATS / 1000.0;
+        if (round == 0 || us < best) {
+            best = us;
+        }
+        *result = total;
+    }
+    return best;
+}
+
+static double time_float_search(const FloatVector* a, const FloatVector* b, const SearchOperation operation,
+                                size_t* result) {
+    double best = 0.0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        struct timespec start, end;
+        size_t total = 0;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int repeat = 0; repeat < SEARCH_REPEATS; repeat++) {
+            size_t value = 0;
+            switch (operation) {
+                case SEARCH_FIND: find_float_vector(a, -1.0f, &value); break;
+                case SEARCH_COUNT: count_float_vector(a, 7.0f, &value); break;
+                default: value = (size_t)is_equal_float_vector(a, b); break;
+            }
+            total += value;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double us = elapsed_ns(&start, &end) / SEARCH_REPEATS / 1000.0;
+        if (round == 0 || us < best) {
+            best = us;
+        }
+        *result = total;
+    }
+    return best;
+}
+
+static void bench_search(void) {
+    Vector ints;
+    Vector ints_copy;
+    FloatVector floats;
+    FloatVector floats_copy;
+    create_vector(&ints, SEARCH_ELEMENTS, NULL, NULL);
+    create_float_vector(&floats, SEARCH_ELEMENTS, NULL, NULL);
+    for (int i = 0; i < SEARCH_ELEMENTS; i++) {
+        push_back_vector(&ints, i % 1000);
+        push_back_float_vector(&floats, (float)(i % 1000));
+    }
+    create_vector(&ints_copy, 0, NULL, NULL);
+    create_float_vector(&floats_copy, 0, NULL, NULL);
+    copy_vector(&ints_copy, &ints);
+    copy_float_vector(&floats_copy, &floats);
+
+    printf("\nSearch over %d elements (scalar vs AVX2)\n", SEARCH_ELEMENTS);
+    printf("%-6s %-9s %12s %12s %9s\n", "type", "operation", "scalar us", "simd us", "speedup");
+    for (int operation = SEARCH_FIND; operation <= SEARCH_EQUAL; operation++) {
+        size_t scalar_result = 0;
+        size_t simd_result = 0;
+        set_vector_simd(0);
+        double scalar_us = time_int_search(&ints, &ints_copy, (SearchOperation)operation, &scalar_result);
+        if (!set_vector_simd(1)) {
+            printf("AVX2 not available; skipping SIMD search timings\n");
+            break;
+        }
+        double simd_us = time_int_search(&ints, &ints_copy, (SearchOperation)operation, &simd_result);
+        printf("%-6s %-9s %12.1f %12.1f %8.2fx%s\n", "int", search_names[operation], scalar_us, simd_us,
+               scalar_us / simd_us, scalar_result == simd_result ? "" : "  MISMATCH");
+
+        set_vector_simd(0);
+        scalar_us = time_float_search(&floats, &floats_copy, (SearchOperation)operation, &scalar_result);
+        set_vector_simd(1);
+        simd_us = time_float_search(&floats, &floats_copy, (SearchOperation)operation, &simd_result);
+        printf("%-6s %-9s %12.1f %12.1f %8.2fx%s\n", "float", search_names[operation], scalar_us, simd_us,
+               scalar_us / simd_us, scalar_result == simd_result ? "" : "  MISMATCH");
+    }
+
+    delete_vector(&ints);
+    delete_vector(&ints_copy);
+    delete_float_vector(&floats);
+    delete_float_vector(&floats_copy);
+}
+
+int main() {
+    const size_t sizes[] = {1, 4, 8, 16};
+
+    printf("Small vectors: create, push, read, delete (%d vectors)\n", BENCH_VECTORS);
+    printf("%-9s %14s %14s %9s\n", "elements", "heap ns/vec", "inline ns/vec", "speedup");
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        long heap_sum = 0;
+        long inline_sum = 0;
+        double heap_ns = time_small_vectors(0, sizes[s], &heap_sum);
+        double inline_ns = time_small_vectors(1, sizes[s], &inline_sum);
+        printf("1..%-6zu %14.2f %14.2f %8.2fx%s\n", sizes[s], heap_ns, inline_ns, heap_ns / inline_ns,
+               heap_sum == inline_sum ? "" : "  MISMATCH");
+    }
+
+    bench_search();
+    bench_churn();
+
+    return 0;
+}
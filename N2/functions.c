@@ -1,6 +1,20 @@
+#define _GNU_SOURCE
+#define _POSIX_C_SOURCE 200809L
 #include "functions.h"
+#include <fcntl.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VECTOR_HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+static int simd_enabled = 1;
 
 const char* vector_status_string(VectorStatus status) {
     switch (status) {
@@ -10,217 +24,722 @@ const char* vector_status_string(VectorStatus status) {
         case VECTOR_ERROR_INDEX_OUT_OF_BOUNDS: return "Index out of bounds";
         case VECTOR_ERROR_EMPTY_VECTOR: return "Empty vector";
         case VECTOR_ERROR_INVALID_CAPACITY: return "Invalid capacity";
+        case VECTOR_ERROR_IO: return "I/O error";
+        case VECTOR_ERROR_INVALID_FILE: return "Invalid vector file";
+        case VECTOR_ERROR_NOT_READY: return "Element not yet written";
         default: return "Unknown error";
     }
 }
 
-VectorStatus create_vector(Vector *vec, size_t initial_capacity, 
-                          VECTOR_TYPE (*CopyFunc)(VECTOR_TYPE), 
-                          void (*DeleteFunc)(VECTOR_TYPE)) {
-    if (!vec) {
-        return VECTOR_ERROR_NULL_POINTER;
+int set_vector_simd(int enabled) {
+    simd_enabled = enabled != 0;
+    return vector_simd_active();
+}
+
+int vector_simd_active(void) {
+#if defined(VECTOR_HAVE_X86)
+    return simd_enabled && __builtin_cpu_supports("avx2");
+#else
+    return 0;
+#endif
+}
+
+#if defined(VECTOR_HAVE_X86)
+/*
+ * AVX2 kernels compare eight lanes per step and stop at the first block with
+ * a hit (find) or a mismatch (equal); the tail goes through the scalar loop.
+ * Floats compare with _CMP_EQ_OQ so NaN and signed zeros behave like ==.
+ */
+__attribute__((target("avx2")))
+static size_t find_int_avx2(const int *data, size_t size, int value) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const __m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+        const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block, needle)));
+        if (mask) {
+            return i + (size_t)__builtin_ctz((unsigned int)mask);
+        }
+    }
+    for (; i < size; i++) {
+        if (data[i] == value) {
+            return i;
+        }
     }
-    
-    vec->capacity = initial_capacity;
-    vec->size = 0;
-    vec->CopyVoidPtr = CopyFunc;
-    vec->DeleteVoidPtr = DeleteFunc;
+    return size;
+}
 
-    if (initial_capacity > 0) {
-        vec->data = (VECTOR_TYPE*)malloc(initial_capacity * sizeof(VECTOR_TYPE));
-        if (!vec->data) {
-            vec->capacity = 0;
-            return VECTOR_ERROR_MEMORY_ALLOCATION;
+__attribute__((target("avx2")))
+static size_t count_int_avx2(const int *data, size_t size, int value) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const __m256i block = _mm256_loadu_si256((const __m256i*)(data + i));
+        const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(block, needle)));
+        count += (size_t)__builtin_popcount((unsigned int)mask);
+    }
+    for (; i < size; i++) {
+        count += data[i] == value;
+    }
+    return count;
+}
+
+__attribute__((target("avx2")))
+static int equal_int_avx2(const int *a, const int *b, size_t size) {
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const __m256i left = _mm256_loadu_si256((const __m256i*)(a + i));
+        const __m256i right = _mm256_loadu_si256((const __m256i*)(b + i));
+        if (_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(left, right))) != 0xFF) {
+            return 0;
+        }
+    }
+    for (; i < size; i++) {
+        if (a[i] != b[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+__attribute__((target("avx2")))
+static size_t find_float_avx2(const float *data, size_t size, float value) {
+    const __m256 needle = _mm256_set1_ps(value);
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ));
+        if (mask) {
+            return i + (size_t)__builtin_ctz((unsigned int)mask);
         }
-    } else if (initial_capacity == 0) {
-        vec->data = NULL;
-    } else {
-        return VECTOR_ERROR_INVALID_CAPACITY;
     }
+    for (; i < size; i++) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return size;
+}
 
-    return VECTOR_SUCCESS;
+__attribute__((target("avx2")))
+static size_t count_float_avx2(const float *data, size_t size, float value) {
+    const __m256 needle = _mm256_set1_ps(value);
+    size_t count = 0;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const int mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + i), needle, _CMP_EQ_OQ));
+        count += (size_t)__builtin_popcount((unsigned int)mask);
+    }
+    for (; i < size; i++) {
+        count += data[i] == value;
+    }
+    return count;
 }
 
-VectorStatus erase_vector(Vector *v) {
-    if (!v) {
-        return VECTOR_ERROR_NULL_POINTER;
+__attribute__((target("avx2")))
+static int equal_float_avx2(const float *a, const float *b, size_t size) {
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const __m256 equal = _mm256_cmp_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), _CMP_EQ_OQ);
+        if (_mm256_movemask_ps(equal) != 0xFF) {
+            return 0;
+        }
     }
-    
-    if (v->data) {
-        if (v->DeleteVoidPtr) {
-            for (size_t i = 0; i < v->size; i++) {
-                v->DeleteVoidPtr(v->data[i]);
-            }
+    for (; i < size; i++) {
+        if (a[i] != b[i]) {
+            return 0;
         }
-        free(v->data);
-        v->data = NULL;
     }
-    v->size = 0;
-    v->capacity = 0;
-    
-    return VECTOR_SUCCESS;
+    return 1;
 }
+#endif
 
-int is_equal_vector(const Vector *v1, const Vector *v2) {
-    if (!v1 || !v2) {
-        return 0;
+size_t vector_find_int(const int *data, size_t size, int value) {
+#if defined(VECTOR_HAVE_X86)
+    if (vector_simd_active()) {
+        return find_int_avx2(data, size, value);
     }
-    if (v1->size != v2->size) {
-        return 0;
+#endif
+    for (size_t i = 0; i < size; i++) {
+        if (data[i] == value) {
+            return i;
+        }
+    }
+    return size;
+}
+
+size_t vector_count_int(const int *data, size_t size, int value) {
+#if defined(VECTOR_HAVE_X86)
+    if (vector_simd_active()) {
+        return count_int_avx2(data, size, value);
+    }
+#endif
+    size_t count = 0;
+    for (size_t i = 0; i < size; i++) {
+        count += data[i] == value;
+    }
+    return count;
+}
+
+int vector_equal_int(const int *a, const int *b, size_t size) {
+#if defined(VECTOR_HAVE_X86)
+    if (vector_simd_active()) {
+        return equal_int_avx2(a, b, size);
     }
-    
-    for (size_t i = 0; i < v1->size; i++) {
-        if (v1->data[i] != v2->data[i]) {
+#endif
+    for (size_t i = 0; i < size; i++) {
+        if (a[i] != b[i]) {
             return 0;
         }
     }
     return 1;
 }
 
-VectorStatus copy_vector(Vector *dest, const Vector *src) {
-    if (!dest || !src) {
-        return VECTOR_ERROR_NULL_POINTER;
+size_t vector_find_float(const float *data, size_t size, float value) {
+#if defined(VECTOR_HAVE_X86)
+    if (vector_simd_active()) {
+        return find_float_avx2(data, size, value);
     }
-    
-    if (dest == src) {
-        return VECTOR_SUCCESS;
-    }
-    
-    VectorStatus status = erase_vector(dest);
-    if (status != VECTOR_SUCCESS) {
-        return status;
-    }
-    
-    dest->size = src->size;
-    dest->capacity = src->capacity;
-    dest->CopyVoidPtr = src->CopyVoidPtr;
-    dest->DeleteVoidPtr = src->DeleteVoidPtr;
-    
-    if (src->capacity > 0) {
-        dest->data = (VECTOR_TYPE*)malloc(src->capacity * sizeof(VECTOR_TYPE));
-        if (!dest->data) {
-            dest->capacity = 0;
-            dest->size = 0;
-            return VECTOR_ERROR_MEMORY_ALLOCATION;
+#endif
+    for (size_t i = 0; i < size; i++) {
+        if (data[i] == value) {
+            return i;
         }
-        
-        for (size_t i = 0; i < src->size; i++) {
-            dest->data[i] = dest->CopyVoidPtr ? dest->CopyVoidPtr(src->data[i]) : src->data[i];
+    }
+    return size;
+}
+
+size_t vector_count_float(const float *data, size_t size, float value) {
+#if defined(VECTOR_HAVE_X86)
+    if (vector_simd_active()) {
+        return count_float_avx2(data, size, value);
+    }
+#endif
+    size_t count = 0;
+    for (size_t i = 0; i < size; i++) {
+        count += data[i] == value;
+    }
+    return count;
+}
+
+int vector_equal_float(const float *a, const float *b, size_t size) {
+#if defined(VECTOR_HAVE_X86)
+    if (vector_simd_active()) {
+        return equal_float_avx2(a, b, size);
+    }
+#endif
+    for (size_t i = 0; i < size; i++) {
+        if (a[i] != b[i]) {
+            return 0;
         }
-    } else {
-        dest->data = NULL;
     }
-    
-    return VECTOR_SUCCESS;
+    return 1;
+}
+
+#define VECTOR_DEFINE_RADIX_SORT(name, U) \
+    int name(U *data, size_t size, int is_signed) { \
+        enum { PASSES = sizeof(U) }; \
+        const U flip = is_signed ? (U)~((U)~(U)0 >> 1) : (U)0; \
+        size_t counts[PASSES][256]; \
+    \
+        U *scratch = (U*)malloc(size * sizeof(U)); \
+        if (!scratch) { \
+            return 0; \
+        } \
+    \
+        memset(counts, 0, sizeof(counts)); \
+        for (size_t i = 0; i < size; i++) { \
+            const U key = (U)(data[i] ^ flip); \
+            for (int pass = 0; pass < PASSES; pass++) { \
+                counts[pass][(key >> (8 * pass)) & 0xFFu]++; \
+            } \
+        } \
+    \
+        U *source = data; \
+        U *target = scratch; \
+        for (int pass = 0; pass < PASSES; pass++) { \
+            const int shift = 8 * pass; \
+            if (counts[pass][((U)(source[0] ^ flip) >> shift) & 0xFFu] == size) { \
+                continue; \
+            } \
+    \
+            size_t offset = 0; \
+            for (int digit = 0; digit < 256; digit++) { \
+                const size_t count = counts[pass][digit]; \
+                counts[pass][digit] = offset; \
+                offset += count; \
+            } \
+            for (size_t i = 0; i < size; i++) { \
+                target[counts[pass][((U)(source[i] ^ flip) >> shift) & 0xFFu]++] = source[i]; \
+            } \
+    \
+            U *swap = source; \
+            source = target; \
+            target = swap; \
+        } \
+    \
+        if (source != data) { \
+            memcpy(data, source, size * sizeof(U)); \
+        } \
+        free(scratch); \
+        return 1; \
+    }
+
+VECTOR_DEFINE_RADIX_SORT(vector_radix_sort_ushort, unsigned short)
+VECTOR_DEFINE_RADIX_SORT(vector_radix_sort_uint, unsigned int)
+VECTOR_DEFINE_RADIX_SORT(vector_radix_sort_ullong, unsigned long long)
+
+size_t vector_segment_of(size_t index, size_t *offset) {
+    const size_t position = index + VECTOR_FIRST_SEGMENT;
+    size_t top = 0;
+#if defined(__GNUC__)
+    top = sizeof(unsigned long long) * 8 - 1 - (size_t)__builtin_clzll((unsigned long long)position);
+#else
+    for (size_t rest = position; rest > 1; rest >>= 1) {
+        top++;
+    }
+#endif
+    *offset = position - ((size_t)1 << top);
+    return top - VECTOR_FIRST_SEGMENT_BITS;
+}
+
+static int valid_file_header(const VectorFileHeader *header, size_t element_size, size_t file_size) {
+    if (memcmp(header->magic, VECTOR_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != VECTOR_FILE_VERSION || header->element_size != element_size) {
+        return 0;
+    }
+    return header->size <= header->capacity &&
+           header->capacity <= (file_size - VECTOR_FILE_HEADER_SIZE) / element_size;
 }
 
-VectorStatus copy_vector_new(const Vector *src, Vector **result) {
-    if (!src || !result) {
+VectorStatus vector_mapping_open(VectorMapping *mapping, const char *path, size_t element_size) {
+    if (!mapping || !path) {
         return VECTOR_ERROR_NULL_POINTER;
     }
-    
-    *result = (Vector*)malloc(sizeof(Vector));
-    if (!*result) {
-        return VECTOR_ERROR_MEMORY_ALLOCATION;
+    if (element_size == 0) {
+        return VECTOR_ERROR_INVALID_CAPACITY;
     }
-    
-    (*result)->size = src->size;
-    (*result)->capacity = src->capacity;
-    (*result)->CopyVoidPtr = src->CopyVoidPtr;
-    (*result)->DeleteVoidPtr = src->DeleteVoidPtr;
-    
-    if (src->capacity > 0) {
-        (*result)->data = (VECTOR_TYPE*)malloc(src->capacity * sizeof(VECTOR_TYPE));
-        if (!(*result)->data) {
-            free(*result);
-            *result = NULL;
-            return VECTOR_ERROR_MEMORY_ALLOCATION;
-        }
-        
-        for (size_t i = 0; i < src->size; i++) {
-            (*result)->data[i] = (*result)->CopyVoidPtr ? 
-                (*result)->CopyVoidPtr(src->data[i]) : src->data[i];
-        }
-    } else {
-        (*result)->data = NULL;
+
+    mapping->fd = -1;
+    mapping->base = NULL;
+    mapping->bytes = 0;
+
+    const int fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return VECTOR_ERROR_IO;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        close(fd);
+        return VECTOR_ERROR_IO;
     }
-    
+
+    const int fresh = file_stat.st_size == 0;
+    if (fresh && ftruncate(fd, VECTOR_FILE_HEADER_SIZE) != 0) {
+        close(fd);
+        return VECTOR_ERROR_IO;
+    }
+    if (!fresh && (size_t)file_stat.st_size < VECTOR_FILE_HEADER_SIZE) {
+        close(fd);
+        return VECTOR_ERROR_INVALID_FILE;
+    }
+
+    const size_t bytes = fresh ? VECTOR_FILE_HEADER_SIZE : (size_t)file_stat.st_size;
+    void *base = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        close(fd);
+        return VECTOR_ERROR_IO;
+    }
+
+    VectorFileHeader *header = (VectorFileHeader*)base;
+    if (fresh) {
+        memcpy(header->magic, VECTOR_FILE_MAGIC, sizeof(header->magic));
+        header->version = VECTOR_FILE_VERSION;
+        header->element_size = (unsigned int)element_size;
+        header->size = 0;
+        header->capacity = 0;
+    } else if (!valid_file_header(header, element_size, bytes)) {
+        munmap(base, bytes);
+        close(fd);
+        return VECTOR_ERROR_INVALID_FILE;
+    }
+
+    mapping->fd = fd;
+    mapping->base = base;
+    mapping->bytes = bytes;
     return VECTOR_SUCCESS;
 }
 
-VectorStatus push_back_vector(Vector *v, VECTOR_TYPE value) {
-    if (!v) {
+VectorStatus vector_mapping_reserve(VectorMapping *mapping, size_t capacity) {
+    if (!mapping || !mapping->base) {
         return VECTOR_ERROR_NULL_POINTER;
     }
-    
-    if (v->size >= v->capacity) {
-        size_t new_capacity;
-        if (v->capacity == 0) {
-            new_capacity = 1;
-        } else {
-            new_capacity = v->capacity * 2;
-        }
-        
-        VECTOR_TYPE *new_data = (VECTOR_TYPE*)realloc(v->data, new_capacity * sizeof(VECTOR_TYPE));
-        if (!new_data) {
+
+    const size_t element_size = ((const VectorFileHeader*)mapping->base)->element_size;
+    if (capacity > ((size_t)-1 - VECTOR_FILE_HEADER_SIZE) / element_size) {
+        return VECTOR_ERROR_INVALID_CAPACITY;
+    }
+
+    const size_t bytes = VECTOR_FILE_HEADER_SIZE + capacity * element_size;
+    if (bytes > mapping->bytes) {
+        if (ftruncate(mapping->fd, (off_t)bytes) != 0) {
+            return VECTOR_ERROR_IO;
+        }
+#if defined(MREMAP_MAYMOVE)
+        void *base = mremap(mapping->base, mapping->bytes, bytes, MREMAP_MAYMOVE);
+#else
+        void *base = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, mapping->fd, 0);
+        if (base != MAP_FAILED) {
+            munmap(mapping->base, mapping->bytes);
+        }
+#endif
+        if (base == MAP_FAILED) {
             return VECTOR_ERROR_MEMORY_ALLOCATION;
         }
-        v->data = new_data;
-        v->capacity = new_capacity;
+        mapping->base = base;
+        mapping->bytes = bytes;
     }
-    
-    v->data[v->size] = v->CopyVoidPtr ? v->CopyVoidPtr(value) : value;
-    v->size++;
-    
+
+    ((VectorFileHeader*)mapping->base)->capacity = capacity;
     return VECTOR_SUCCESS;
 }
 
-VectorStatus delete_at_vector(Vector *v, size_t index, VECTOR_TYPE *deleted_value) {
-    if (!v) {
+VectorStatus vector_mapping_sync(VectorMapping *mapping) {
+    if (!mapping || !mapping->base) {
         return VECTOR_ERROR_NULL_POINTER;
     }
-    
-    if (v->size == 0) {
-        return VECTOR_ERROR_EMPTY_VECTOR;
+
+    return msync(mapping->base, mapping->bytes, MS_SYNC) == 0 ? VECTOR_SUCCESS : VECTOR_ERROR_IO;
+}
+
+VectorStatus vector_mapping_close(VectorMapping *mapping) {
+    if (!mapping || !mapping->base) {
+        return VECTOR_ERROR_NULL_POINTER;
     }
-    
-    if (index >= v->size) {
-        return VECTOR_ERROR_INDEX_OUT_OF_BOUNDS;
+
+    const int unmapped = munmap(mapping->base, mapping->bytes) == 0;
+    const int closed = close(mapping->fd) == 0;
+    mapping->fd = -1;
+    mapping->base = NULL;
+    mapping->bytes = 0;
+    return unmapped && closed ? VECTOR_SUCCESS : VECTOR_ERROR_IO;
+}
+
+#define VARINT_MAX_BYTES 10
+
+static unsigned long long fnv1a(const void *data, size_t bytes) {
+    const unsigned char *p = (const unsigned char*)data;
+    unsigned long long hash = 14695981039346656037ull;
+    for (size_t i = 0; i < bytes; i++) {
+        hash = (hash ^ p[i]) * 1099511628211ull;
     }
-    
-    if (deleted_value) {
-        *deleted_value = v->data[index];
+    return hash;
+}
+
+/* Reads element i widened to 64 bits, sign-extending when is_signed. */
+static unsigned long long load_integer(const unsigned char *data, size_t i, size_t element_size, int is_signed) {
+    switch (element_size) {
+        case 1: {
+            unsigned char value = data[i];
+            return is_signed ? (unsigned long long)(long long)(signed char)value : value;
+        }
+        case 2: {
+            unsigned short value;
+            memcpy(&value, data + i * 2, 2);
+            return is_signed ? (unsigned long long)(long long)(short)value : value;
+        }
+        case 4: {
+            unsigned int value;
+            memcpy(&value, data + i * 4, 4);
+            return is_signed ? (unsigned long long)(long long)(int)value : value;
+        }
+        default: {
+            unsigned long long value;
+            memcpy(&value, data + i * 8, 8);
+            return value;
+        }
     }
-    
-    if (v->DeleteVoidPtr) {
-        v->DeleteVoidPtr(v->data[index]);
+}
+
+/* Stores the low element_size bytes of value as element i. */
+static void store_integer(unsigned char *data, size_t i, size_t element_size, unsigned long long value) {
+    switch (element_size) {
+        case 1: data[i] = (unsigned char)value; break;
+        case 2: { unsigned short narrow = (unsigned short)value; memcpy(data + i * 2, &narrow, 2); break; }
+        case 4: { unsigned int narrow = (unsigned int)value; memcpy(data + i * 4, &narrow, 4); break; }
+        default: memcpy(data + i * 8, &value, 8); break;
     }
+}
 
-    for (size_t i = index; i < v->size - 1; i++) {
-        v->data[i] = v->data[i + 1];
+static size_t delta_varint_encode(const void *data, size_t size, size_t element_size, int is_signed,
+                                  unsigned char *out) {
+    unsigned long long previous = 0;
+    size_t written = 0;
+    for (size_t i = 0; i < size; i++) {
+        const unsigned long long value = load_integer((const unsigned char*)data, i, element_size, is_signed);
+        const unsigned long long delta = value - previous;
+        unsigned long long zigzag = (delta << 1) ^ (0ull - (delta >> 63));
+        previous = value;
+        while (zigzag >= 0x80) {
+            out[written++] = (unsigned char)(zigzag | 0x80);
+            zigzag >>= 7;
+        }
+        out[written++] = (unsigned char)zigzag;
     }
-    v->size--;
-    
-    return VECTOR_SUCCESS;
+    return written;
+}
+
+/* Returns 0 if in does not hold exactly size well-formed varints. */
+static int delta_varint_decode(const unsigned char *in, size_t bytes, void *data, size_t size, size_t element_size) {
+    unsigned long long previous = 0;
+    size_t read = 0;
+    for (size_t i = 0; i < size; i++) {
+        unsigned long long zigzag = 0;
+        for (int shift = 0;; shift += 7) {
+            if (read == bytes || shift >= VARINT_MAX_BYTES * 7) {
+                return 0;
+            }
+            const unsigned char byte = in[read++];
+            zigzag |= (unsigned long long)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                break;
+            }
+        }
+        previous += (zigzag >> 1) ^ (0ull - (zigzag & 1));
+        store_integer((unsigned char*)data, i, element_size, previous);
+    }
+    return read == bytes;
 }
 
-VectorStatus get_at_vector(const Vector *v, size_t index, VECTOR_TYPE *result) {
-    if (!v || !result) {
+VectorStatus vector_binary_save(const char *path, const void *data, size_t size, size_t element_size,
+                                VectorEncoding encoding, int is_integer, int is_signed) {
+    if (!path || (!data && size > 0)) {
         return VECTOR_ERROR_NULL_POINTER;
     }
-    
-    if (index >= v->size) {
-        return VECTOR_ERROR_INDEX_OUT_OF_BOUNDS;
+    if (element_size == 0 || size > (size_t)-1 / VARINT_MAX_BYTES) {
+        return VECTOR_ERROR_INVALID_CAPACITY;
     }
-    
-    *result = v->data[index];
-    return VECTOR_SUCCESS;
+
+    VectorBinaryHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, VECTOR_BINARY_MAGIC, sizeof(header.magic));
+    header.version = VECTOR_BINARY_VERSION;
+    header.element_size = (unsigned int)element_size;
+    header.size = size;
+
+    const int delta = encoding == VECTOR_ENCODING_DELTA_VARINT && is_integer && element_size <= 8 &&
+                      (element_size & (element_size - 1)) == 0;
+    const void *payload = data;
+    unsigned char *encoded = NULL;
+    if (delta) {
+        encoded = (unsigned char*)malloc(size > 0 ? size * VARINT_MAX_BYTES : 1);
+        if (!encoded) {
+            return VECTOR_ERROR_MEMORY_ALLOCATION;
+        }
+        header.encoding = VECTOR_ENCODING_DELTA_VARINT;
+        header.payload_bytes = delta_varint_encode(data, size, element_size, is_signed, encoded);
+        payload = encoded;
+    } else {
+        header.encoding = VECTOR_ENCODING_RAW;
+        header.payload_bytes = (unsigned long long)size * element_size;
+    }
+    header.checksum = fnv1a(payload, (size_t)header.payload_bytes);
+
+    VectorStatus status = VECTOR_SUCCESS;
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        status = VECTOR_ERROR_IO;
+    } else {
+        if (fwrite(&header, sizeof(header), 1, file) != 1 ||
+            (header.payload_bytes > 0 && fwrite(payload, (size_t)header.payload_bytes, 1, file) != 1)) {
+            status = VECTOR_ERROR_IO;
+        }
+        if (fclose(file) != 0) {
+            status = VECTOR_ERROR_IO;
+        }
+    }
+    free(encoded);
+    return status;
+}
+
+static int valid_binary_header(const VectorBinaryHeader *header, size_t element_size) {
+    if (memcmp(header->magic, VECTOR_BINARY_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != VECTOR_BINARY_VERSION || header->element_size != element_size ||
+        header->size > (size_t)-1 / VARINT_MAX_BYTES || header->size > (size_t)-1 / element_size) {
+        return 0;
+    }
+    if (header->encoding == VECTOR_ENCODING_RAW) {
+        return header->payload_bytes == header->size * element_size;
+    }
+    return header->encoding == VECTOR_ENCODING_DELTA_VARINT &&
+           header->payload_bytes >= header->size && header->payload_bytes <= header->size * VARINT_MAX_BYTES;
 }
 
-VectorStatus delete_vector(Vector *v) {
-    if (!v) {
+VectorStatus vector_binary_load(const char *path, size_t element_size,
+                                void *(*storage)(void *context, size_t size), void *context, size_t *size) {
+    if (!path || !storage || !size) {
         return VECTOR_ERROR_NULL_POINTER;
     }
-    
-    return erase_vector(v);
-}
\ No newline at end of file
+
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return VECTOR_ERROR_IO;
+    }
+
+    VectorBinaryHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 || !valid_binary_header(&header, element_size)) {
+        fclose(file);
+        return VECTOR_ERROR_INVALID_FILE;
+    }
+
+    /* Check the payload against the real file length before sizing storage from the header. */
+    struct stat info;
+    if (fstat(fileno(file), &info) != 0) {
+        fclose(file);
+        return VECTOR_ERROR_IO;
+    }
+    if ((unsigned long long)info.st_size - sizeof(header) != header.payload_bytes) {
+        fclose(file);
+        return VECTOR_ERROR_INVALID_FILE;
+    }
+
+    const size_t count = (size_t)header.size;
+    const size_t bytes = (size_t)header.payload_bytes;
+    void *data = storage(context, count);
+    if (!data && count > 0) {
+        fclose(file);
+        return VECTOR_ERROR_MEMORY_ALLOCATION;
+    }
+
+    VectorStatus status = VECTOR_SUCCESS;
+    if (header.encoding == VECTOR_ENCODING_RAW) {
+        if ((bytes > 0 && fread(data, bytes, 1, file) != 1) || fnv1a(data, bytes) != header.checksum) {
+            status = VECTOR_ERROR_INVALID_FILE;
+        }
+    } else {
+        unsigned char *encoded = (unsigned char*)malloc(bytes > 0 ? bytes : 1);
+        if (!encoded) {
+            status = VECTOR_ERROR_MEMORY_ALLOCATION;
+        } else if ((bytes > 0 && fread(encoded, bytes, 1, file) != 1) || fnv1a(encoded, bytes) != header.checksum ||
+                   !delta_varint_decode(encoded, bytes, data, count, element_size)) {
+            status = VECTOR_ERROR_INVALID_FILE;
+        }
+        free(encoded);
+    }
+    fclose(file);
+
+    if (status == VECTOR_SUCCESS) {
+        *size = count;
+    }
+    return status;
+}
+
+/* Size class for size bytes, or VECTOR_POOL_CLASSES when it is too large to pool. */
+static size_t pool_class_of(size_t size) {
+    if (size > VECTOR_POOL_MAX_BLOCK) {
+        return VECTOR_POOL_CLASSES;
+    }
+    size_t shift = VECTOR_POOL_MIN_SHIFT;
+    while (((size_t)1 << shift) < size) {
+        shift++;
+    }
+    return shift - VECTOR_POOL_MIN_SHIFT;
+}
+
+static void *pool_allocate(void *context, size_t size) {
+    VectorPool *pool = (VectorPool*)context;
+    const size_t size_class = pool_class_of(size);
+    if (size_class == VECTOR_POOL_CLASSES) {
+        pool->system_allocations++;
+        return malloc(size);
+    }
+
+    void *block = pool->free_lists[size_class];
+    if (block) {
+        memcpy(&pool->free_lists[size_class], block, sizeof(void*));
+        pool->cached[size_class]--;
+        pool->reused++;
+        return block;
+    }
+    pool->system_allocations++;
+    return malloc((size_t)1 << (size_class + VECTOR_POOL_MIN_SHIFT));
+}
+
+static void pool_release(void *context, void *pointer, size_t size) {
+    VectorPool *pool = (VectorPool*)context;
+    const size_t size_class = pool_class_of(size);
+    if (!pointer) {
+        return;
+    }
+    if (size_class == VECTOR_POOL_CLASSES || pool->cached[size_class] >= pool->max_cached) {
+        free(pointer);
+        return;
+    }
+
+    memcpy(pointer, &pool->free_lists[size_class], sizeof(void*));
+    pool->free_lists[size_class] = pointer;
+    pool->cached[size_class]++;
+}
+
+static void *pool_reallocate(void *context, void *pointer, size_t old_size, size_t new_size) {
+    VectorPool *pool = (VectorPool*)context;
+    if (!pointer) {
+        return pool_allocate(context, new_size);
+    }
+
+    const size_t old_class = pool_class_of(old_size);
+    const size_t new_class = pool_class_of(new_size);
+    if (old_class == VECTOR_POOL_CLASSES && new_class == VECTOR_POOL_CLASSES) {
+        pool->system_allocations++;
+        return realloc(pointer, new_size);
+    }
+    if (old_class == new_class) {
+        return pointer;
+    }
+
+    void *moved = pool_allocate(context, new_size);
+    if (moved) {
+        memcpy(moved, pointer, old_size < new_size ? old_size : new_size);
+        pool_release(context, pointer, old_size);
+    }
+    return moved;
+}
+
+void vector_pool_init(VectorPool *pool, size_t max_cached) {
+    for (size_t c = 0; c < VECTOR_POOL_CLASSES; c++) {
+        pool->free_lists[c] = NULL;
+        pool->cached[c] = 0;
+    }
+    pool->max_cached = max_cached;
+    pool->system_allocations = 0;
+    pool->reused = 0;
+}
+
+void vector_pool_destroy(VectorPool *pool) {
+    for (size_t c = 0; c < VECTOR_POOL_CLASSES; c++) {
+        void *block = pool->free_lists[c];
+        while (block) {
+            void *next;
+            memcpy(&next, block, sizeof(void*));
+            free(block);
+            block = next;
+        }
+        pool->free_lists[c] = NULL;
+        pool->cached[c] = 0;
+    }
+}
+
+VectorAllocator vector_pool_allocator(VectorPool *pool) {
+    VectorAllocator allocator;
+    allocator.allocate = pool_allocate;
+    allocator.reallocate = pool_reallocate;
+    allocator.release = pool_release;
+    allocator.context = pool;
+    return allocator;
+}
+
+DEFINE_VECTOR(Vector, vector, VECTOR_TYPE)
+DEFINE_SMALL_VECTOR(SmallVector, small_vector, vector, VECTOR_TYPE, VECTOR_INLINE_CAPACITY)
+DEFINE_CONCURRENT_VECTOR(ConcurrentVector, concurrent_vector, VECTOR_TYPE)
+DEFINE_MAPPED_VECTOR(MappedVector, mapped_vector, VECTOR_TYPE)
\ No newline at end of file
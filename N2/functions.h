@@ -2,40 +2,1616 @@
 #define FUNCTIONS_H
 
 #include <stdlib.h>
+#include <string.h>
 
 #ifndef VECTOR_TYPE
 #define VECTOR_TYPE int
 #endif
 
+#define VECTOR_DEFAULT_GROWTH_FACTOR 2.0
+#define VECTOR_MAX_GROWTH_FACTOR 16.0
+
+/* Inline elements of the default SmallVector instantiation. */
+#ifndef VECTOR_INLINE_CAPACITY
+#define VECTOR_INLINE_CAPACITY 8
+#endif
+
 typedef enum {
     VECTOR_SUCCESS = 0,
     VECTOR_ERROR_NULL_POINTER,
     VECTOR_ERROR_MEMORY_ALLOCATION,
     VECTOR_ERROR_INDEX_OUT_OF_BOUNDS,
     VECTOR_ERROR_EMPTY_VECTOR,
-    VECTOR_ERROR_INVALID_CAPACITY
+    VECTOR_ERROR_INVALID_CAPACITY,
+    VECTOR_ERROR_IO,
+    VECTOR_ERROR_INVALID_FILE,
+    VECTOR_ERROR_NOT_READY
 } VectorStatus;
 
+const char* vector_status_string(VectorStatus status);
+
+/*
+ * Search and equality kernels for int and float elements, used by the
+ * template for those types. They run AVX2 when the CPU supports it and SIMD
+ * is enabled, the scalar loop otherwise. set_vector_simd returns whether
+ * the AVX2 path is in effect afterwards.
+ */
+int set_vector_simd(int enabled);
+int vector_simd_active(void);
+size_t vector_find_int(const int *data, size_t size, int value);
+size_t vector_count_int(const int *data, size_t size, int value);
+int vector_equal_int(const int *a, const int *b, size_t size);
+size_t vector_find_float(const float *data, size_t size, float value);
+size_t vector_count_float(const float *data, size_t size, float value);
+int vector_equal_float(const float *a, const float *b, size_t size);
+
+/*
+ * LSD radix sorts, one byte per pass; is_signed flips the sign bit so signed
+ * values order correctly. They return 0 if the scratch buffer cannot be
+ * allocated, leaving data untouched.
+ */
+int vector_radix_sort_ushort(unsigned short *data, size_t size, int is_signed);
+int vector_radix_sort_uint(unsigned int *data, size_t size, int is_signed);
+int vector_radix_sort_ullong(unsigned long long *data, size_t size, int is_signed);
+
+#if defined(__GNUC__)
+#define VECTOR_IS_TYPE(T, U) __builtin_types_compatible_p(T, U)
+#else
+#define VECTOR_IS_TYPE(T, U) 0
+#endif
+
+#define VECTOR_IS_SIGNED_INTEGER(T) (VECTOR_IS_TYPE(T, short) || VECTOR_IS_TYPE(T, int) || \
+    VECTOR_IS_TYPE(T, long) || VECTOR_IS_TYPE(T, long long))
+#define VECTOR_IS_UNSIGNED_INTEGER(T) (VECTOR_IS_TYPE(T, unsigned short) || VECTOR_IS_TYPE(T, unsigned int) || \
+    VECTOR_IS_TYPE(T, unsigned long) || VECTOR_IS_TYPE(T, unsigned long long))
+
+/*
+ * Binary save/load format: a VectorBinaryHeader in native byte order followed
+ * by the payload, which is either the raw elements or, for integer element
+ * types, zigzag varints of the differences between consecutive elements.
+ * checksum is the 64-bit FNV-1a hash of the payload as stored.
+ */
+#define VECTOR_BINARY_MAGIC "N2VECBIN"
+#define VECTOR_BINARY_VERSION 1u
+
+typedef enum {
+    VECTOR_ENCODING_RAW = 0,
+    VECTOR_ENCODING_DELTA_VARINT
+} VectorEncoding;
+
 typedef struct {
-    VECTOR_TYPE *data;
-    size_t size;
-    size_t capacity;
-    VECTOR_TYPE (*CopyVoidPtr)(VECTOR_TYPE);
-    void (*DeleteVoidPtr)(VECTOR_TYPE);
-} Vector;
-
-VectorStatus create_vector(Vector *vec, size_t initial_capacity, 
-                          VECTOR_TYPE (*CopyFunc)(VECTOR_TYPE), 
-                          void (*DeleteFunc)(VECTOR_TYPE));
-VectorStatus erase_vector(Vector *v);
-int is_equal_vector(const Vector *v1, const Vector *v2);
-VectorStatus copy_vector(Vector *dest, const Vector *src);
-VectorStatus copy_vector_new(const Vector *src, Vector **result);
-VectorStatus push_back_vector(Vector *v, VECTOR_TYPE value);
-VectorStatus delete_at_vector(Vector *v, size_t index, VECTOR_TYPE *deleted_value);
-VectorStatus get_at_vector(const Vector *v, size_t index, VECTOR_TYPE *result);
-VectorStatus delete_vector(Vector *v);
+    char magic[8];
+    unsigned int version;
+    unsigned int element_size;
+    unsigned int encoding;
+    unsigned int reserved;
+    unsigned long long size;
+    unsigned long long payload_bytes;
+    unsigned long long checksum;
+} VectorBinaryHeader;
 
-const char* vector_status_string(VectorStatus status);
+/*
+ * Writes size elements to path. VECTOR_ENCODING_DELTA_VARINT applies only when
+ * is_integer is set (is_signed selects sign extension); other data is stored raw.
+ */
+VectorStatus vector_binary_save(const char *path, const void *data, size_t size, size_t element_size,
+                                VectorEncoding encoding, int is_integer, int is_signed);
+/*
+ * Reads the file at path after validating its header and checking that the
+ * file holds exactly payload_bytes after it. storage(context, size)
+ * must return room for size elements; the payload is read there, or into one
+ * scratch buffer when encoded, with a single fread. *size receives the count.
+ */
+VectorStatus vector_binary_load(const char *path, size_t element_size,
+                                void *(*storage)(void *context, size_t size), void *context, size_t *size);
+
+/*
+ * Vector template. DECLARE_VECTOR(Name, suffix, T) declares the struct Name
+ * and its API, each function named <operation>_<suffix> (push_back_<suffix>,
+ * copy_<suffix>_new, ...). DEFINE_VECTOR emits the implementation and belongs
+ * in exactly one translation unit. DEFINE_VECTOR_WITH takes EQUAL(a, b) and
+ * LESS(a, b) macros or functions for element types without == and <, such
+ * as structs; only DEFINE_VECTOR routes int and float searches and integer
+ * sorts through the SIMD and radix kernels. Invocations take no trailing
+ * semicolon.
+ */
+/*
+ * Pluggable storage for vector buffers. Sizes are in bytes, and reallocate and
+ * release receive the size the block currently has, so an allocator does not
+ * need per-block headers. A vector without an allocator uses malloc/realloc/free.
+ */
+typedef struct {
+    void *(*allocate)(void *context, size_t size);
+    void *(*reallocate)(void *context, void *pointer, size_t old_size, size_t new_size);
+    void (*release)(void *context, void *pointer, size_t size);
+    void *context;
+} VectorAllocator;
+
+/*
+ * Size-class pool: requests up to VECTOR_POOL_MAX_BLOCK bytes are rounded up to
+ * a power of two and released blocks are kept on a per-class free list (at
+ * most max_cached per class) for the next request of that class. Larger
+ * requests go straight to malloc. Not thread-safe; use one pool per thread.
+ */
+#define VECTOR_POOL_MIN_SHIFT 4
+#define VECTOR_POOL_MAX_SHIFT 16
+#define VECTOR_POOL_MAX_BLOCK ((size_t)1 << VECTOR_POOL_MAX_SHIFT)
+#define VECTOR_POOL_CLASSES (VECTOR_POOL_MAX_SHIFT - VECTOR_POOL_MIN_SHIFT + 1)
+
+typedef struct {
+    void *free_lists[VECTOR_POOL_CLASSES];
+    size_t cached[VECTOR_POOL_CLASSES];
+    size_t max_cached;
+    size_t system_allocations;
+    size_t reused;
+} VectorPool;
+
+void vector_pool_init(VectorPool *pool, size_t max_cached);
+/* Frees every cached block; buffers still owned by vectors must be released first. */
+void vector_pool_destroy(VectorPool *pool);
+VectorAllocator vector_pool_allocator(VectorPool *pool);
+
+#define VECTOR_DEFAULT_EQUAL(a, b) ((a) == (b))
+#define VECTOR_DEFAULT_LESS(a, b) ((a) < (b))
+
+/* Below this many elements sort_<suffix> uses introsort even for integers. */
+#define VECTOR_RADIX_THRESHOLD 64
+
+#define DECLARE_VECTOR(Name, suffix, T) \
+    typedef struct { \
+        T *data; \
+        size_t size; \
+        size_t capacity; \
+        T (*CopyVoidPtr)(T); \
+        void (*DeleteVoidPtr)(T); \
+        int trivial; \
+        double growth_factor; \
+        size_t growth_increment; \
+        size_t *shared; \
+        int copy_on_write; \
+        const VectorAllocator *allocator; \
+        T *inline_data; \
+        size_t inline_capacity; \
+    } Name; \
+    \
+    VectorStatus create_##suffix(Name *vec, size_t initial_capacity, T (*CopyFunc)(T), void (*DeleteFunc)(T)); \
+    /* \
+     * Like create_<suffix>, but heap storage comes from allocator, which must \
+     * outlive the vector. copy_<suffix>_new gives the copy the same allocator. \
+     */ \
+    VectorStatus create_with_allocator_##suffix(Name *vec, size_t initial_capacity, T (*CopyFunc)(T), \
+                                                void (*DeleteFunc)(T), const VectorAllocator *allocator); \
+    /* \
+     * Small-buffer variant: the first capacity elements live in storage, which \
+     * must outlive the vector, and the heap is used only once the vector outgrows \
+     * it; erase_<suffix> returns the vector to storage. DECLARE_SMALL_VECTOR \
+     * bundles a vector with its own storage. \
+     */ \
+    VectorStatus create_inline_##suffix(Name *vec, T *storage, size_t capacity, \
+                                        T (*CopyFunc)(T), void (*DeleteFunc)(T)); \
+    int is_inline_##suffix(const Name *v); \
+    VectorStatus erase_##suffix(Name *v); \
+    int is_equal_##suffix(const Name *v1, const Name *v2); \
+    VectorStatus copy_##suffix(Name *dest, const Name *src); \
+    VectorStatus copy_##suffix##_new(const Name *src, Name **result); \
+    VectorStatus push_back_##suffix(Name *v, T value); \
+    VectorStatus delete_at_##suffix(Name *v, size_t index, T *deleted_value); \
+    VectorStatus get_at_##suffix(const Name *v, size_t index, T *result); \
+    VectorStatus delete_##suffix(Name *v); \
+    \
+    /* \
+     * A trivial vector skips CopyVoidPtr/DeleteVoidPtr: copies become one \
+     * memcpy and destruction has no per-element loop. Vectors created without \
+     * callbacks start trivial; set_trivial_<suffix> marks identity callbacks. \
+     */ \
+    VectorStatus set_trivial_##suffix(Name *v, int trivial); \
+    \
+    /* \
+     * Copy-on-write. copy_<suffix>_new of a vector with copy_on_write set shares \
+     * its heap buffer under a reference count instead of copying it, so the \
+     * copy costs O(1); each holder duplicates the buffer on its first mutating \
+     * call. Code that writes through data directly must call detach_<suffix> \
+     * first. copy_<suffix> into an existing vector always copies. While \
+     * copy_on_write is set the vector owns a reference count (shared), which \
+     * copy_<suffix>_new only increments; inline storage is never shared. \
+     */ \
+    VectorStatus set_copy_on_write_##suffix(Name *v, int enabled); \
+    VectorStatus detach_##suffix(Name *v); \
+    \
+    /* \
+     * Capacity management. reserve_<suffix> never shrinks; shrink_to_fit_<suffix> \
+     * trims heap storage to size. A growth_increment above zero grows by that \
+     * many elements, otherwise capacity is multiplied by growth_factor, which \
+     * must lie in (1, VECTOR_MAX_GROWTH_FACTOR]. \
+     */ \
+    VectorStatus reserve_##suffix(Name *v, size_t capacity); \
+    VectorStatus shrink_to_fit_##suffix(Name *v); \
+    VectorStatus set_growth_policy_##suffix(Name *v, double growth_factor, size_t growth_increment); \
+    \
+    /* \
+     * Bulk operations: one capacity check and, without a copy callback, one \
+     * memcpy/memmove per call. values must not point into v itself. \
+     */ \
+    VectorStatus append_range_##suffix(Name *v, const T *values, size_t count); \
+    VectorStatus insert_range_##suffix(Name *v, size_t index, const T *values, size_t count); \
+    VectorStatus erase_range_##suffix(Name *v, size_t index, size_t count); \
+    \
+    /* O(1) removal that fills the hole with the last element, not keeping order. */ \
+    VectorStatus swap_remove_##suffix(Name *v, size_t index, T *deleted_value); \
+    \
+    /* \
+     * Removes every element for which predicate returns non-zero, compacting \
+     * the survivors in one pass while keeping their relative order. \
+     * removed_count (may be NULL) receives the number of elements removed. \
+     */ \
+    VectorStatus remove_if_##suffix(Name *v, int (*predicate)(T, void*), void *context, size_t *removed_count); \
+    \
+    /* \
+     * Linear search. find_<suffix> stores the first matching index, or size \
+     * when there is none; count_<suffix> stores the number of matches. \
+     */ \
+    VectorStatus find_##suffix(const Name *v, T value, size_t *index); \
+    VectorStatus count_##suffix(const Name *v, T value, size_t *count); \
+    int contains_##suffix(const Name *v, T value); \
+    \
+    /* \
+     * Ordering by LESS. sort_<suffix> radix-sorts vectors of the standard \
+     * integer types, signed or unsigned, and introsorts everything else. The \
+     * sorted_ functions expect sorted input: lower_bound_<suffix> stores the first index \
+     * whose element is not less than value, insert_sorted_<suffix> inserts there \
+     * (index may be NULL), and merge_sorted_<suffix> replaces dest, which must \
+     * be initialized and distinct from a and b, with their stable merge. \
+     */ \
+    VectorStatus sort_##suffix(Name *v); \
+    VectorStatus lower_bound_##suffix(const Name *v, T value, size_t *index); \
+    VectorStatus insert_sorted_##suffix(Name *v, T value, size_t *index); \
+    VectorStatus merge_sorted_##suffix(Name *dest, const Name *a, const Name *b); \
+    \
+    /* \
+     * Binary persistence for element types stored as raw bytes; callbacks are \
+     * not applied. load_<suffix> replaces the contents of an initialized vector. \
+     * A file whose header or length is invalid leaves the vector untouched; one \
+     * whose payload fails the checksum or decoding leaves it detached and empty. \
+     */ \
+    VectorStatus save_##suffix(const Name *v, const char *path, VectorEncoding encoding); \
+    VectorStatus load_##suffix(Name *v, const char *path);
+
+#define DEFINE_VECTOR(Name, suffix, T) \
+    DEFINE_VECTOR_IMPL(Name, suffix, T, VECTOR_DEFAULT_EQUAL, VECTOR_DEFAULT_LESS, 1)
+#define DEFINE_VECTOR_WITH(Name, suffix, T, EQUAL, LESS) \
+    DEFINE_VECTOR_IMPL(Name, suffix, T, EQUAL, LESS, 0)
+
+/* BUILTIN is 1 when EQUAL and LESS are the built-in operators, enabling type-specific kernels. */
+#define DEFINE_VECTOR_IMPL(Name, suffix, T, EQUAL, LESS, BUILTIN) \
+    static T *allocate_data_##suffix(const Name *v, size_t capacity) { \
+        if (v->allocator) { \
+            return (T*)v->allocator->allocate(v->allocator->context, capacity * sizeof(T)); \
+        } \
+        return (T*)malloc(capacity * sizeof(T)); \
+    } \
+    \
+    static T *reallocate_data_##suffix(const Name *v, size_t new_capacity) { \
+        if (v->allocator) { \
+            return (T*)v->allocator->reallocate(v->allocator->context, v->data, \
+                                                v->capacity * sizeof(T), new_capacity * sizeof(T)); \
+        } \
+        return (T*)realloc(v->data, new_capacity * sizeof(T)); \
+    } \
+    \
+    static void release_data_##suffix(const Name *v, T *data, size_t capacity) { \
+        if (v->allocator) { \
+            v->allocator->release(v->allocator->context, data, capacity * sizeof(T)); \
+        } else { \
+            free(data); \
+        } \
+    } \
+    \
+    VectorStatus create_##suffix(Name *vec, size_t initial_capacity, T (*CopyFunc)(T), void (*DeleteFunc)(T)) { \
+        return create_with_allocator_##suffix(vec, initial_capacity, CopyFunc, DeleteFunc, NULL); \
+    } \
+    \
+    VectorStatus create_with_allocator_##suffix(Name *vec, size_t initial_capacity, T (*CopyFunc)(T), \
+                                                void (*DeleteFunc)(T), const VectorAllocator *allocator) { \
+        if (!vec) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        vec->capacity = initial_capacity; \
+        vec->size = 0; \
+        vec->CopyVoidPtr = CopyFunc; \
+        vec->DeleteVoidPtr = DeleteFunc; \
+        vec->trivial = !CopyFunc && !DeleteFunc; \
+        vec->growth_factor = VECTOR_DEFAULT_GROWTH_FACTOR; \
+        vec->growth_increment = 0; \
+        vec->shared = NULL; \
+        vec->copy_on_write = 0; \
+        vec->allocator = allocator; \
+        vec->inline_data = NULL; \
+        vec->inline_capacity = 0; \
+    \
+        if (initial_capacity > 0) { \
+            vec->data = allocate_data_##suffix(vec, initial_capacity); \
+            if (!vec->data) { \
+                vec->capacity = 0; \
+                return VECTOR_ERROR_MEMORY_ALLOCATION; \
+            } \
+        } else if (initial_capacity == 0) { \
+            vec->data = NULL; \
+        } else { \
+            return VECTOR_ERROR_INVALID_CAPACITY; \
+        } \
+    \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus create_inline_##suffix(Name *vec, T *storage, size_t capacity, \
+                                        T (*CopyFunc)(T), void (*DeleteFunc)(T)) { \
+        if (!vec || !storage) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        if (capacity == 0) { \
+            return VECTOR_ERROR_INVALID_CAPACITY; \
+        } \
+    \
+        vec->data = storage; \
+        vec->size = 0; \
+        vec->capacity = capacity; \
+        vec->CopyVoidPtr = CopyFunc; \
+        vec->DeleteVoidPtr = DeleteFunc; \
+        vec->trivial = !CopyFunc && !DeleteFunc; \
+        vec->growth_factor = VECTOR_DEFAULT_GROWTH_FACTOR; \
+        vec->growth_increment = 0; \
+        vec->shared = NULL; \
+        vec->copy_on_write = 0; \
+        vec->allocator = NULL; \
+        vec->inline_data = storage; \
+        vec->inline_capacity = capacity; \
+    \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    int is_inline_##suffix(const Name *v) { \
+        return v && v->inline_data && v->data == v->inline_data; \
+    } \
+    \
+    static VectorStatus grow_##suffix(Name *v, size_t new_capacity) { \
+        T *new_data; \
+    \
+        if (is_inline_##suffix(v)) { \
+            new_data = allocate_data_##suffix(v, new_capacity); \
+            if (new_data) { \
+                memcpy(new_data, v->inline_data, v->size * sizeof(T)); \
+            } \
+        } else { \
+            new_data = reallocate_data_##suffix(v, new_capacity); \
+        } \
+        if (!new_data) { \
+            return VECTOR_ERROR_MEMORY_ALLOCATION; \
+        } \
+    \
+        v->data = new_data; \
+        v->capacity = new_capacity; \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    static size_t next_capacity_##suffix(const Name *v) { \
+        if (v->capacity == 0) { \
+            return 1; \
+        } \
+    \
+        const size_t max_capacity = (size_t)-1 / sizeof(T); \
+        size_t new_capacity; \
+        if (v->growth_increment > 0) { \
+            new_capacity = v->growth_increment > max_capacity - v->capacity \
+                ? max_capacity : v->capacity + v->growth_increment; \
+        } else { \
+            double grown = (double)v->capacity * v->growth_factor; \
+            new_capacity = grown >= (double)max_capacity ? max_capacity : (size_t)grown; \
+        } \
+        return new_capacity > v->capacity ? new_capacity : v->capacity + 1; \
+    } \
+    \
+    static VectorStatus ensure_capacity_##suffix(Name *v, size_t extra) { \
+        if (extra > (size_t)-1 / sizeof(T) - v->size) { \
+            return VECTOR_ERROR_INVALID_CAPACITY; \
+        } \
+    \
+        const size_t required = v->size + extra; \
+        if (required <= v->capacity) { \
+            return VECTOR_SUCCESS; \
+        } \
+    \
+        size_t new_capacity = next_capacity_##suffix(v); \
+        return grow_##suffix(v, new_capacity > required ? new_capacity : required); \
+    } \
+    \
+    static void copy_elements_##suffix(const Name *v, T *dest, const T *src, size_t count) { \
+        if (!v->trivial && v->CopyVoidPtr) { \
+            for (size_t i = 0; i < count; i++) { \
+                dest[i] = v->CopyVoidPtr(src[i]); \
+            } \
+        } else if (count > 0) { \
+            memcpy(dest, src, count * sizeof(T)); \
+        } \
+    } \
+    \
+    /* \
+     * Gives dest storage for src's elements: its own inline storage when they \
+     * fit, otherwise src->capacity elements on the heap. \
+     */ \
+    static VectorStatus allocate_copy_storage_##suffix(Name *dest, const Name *src) { \
+        if (dest->inline_data && src->size <= dest->inline_capacity) { \
+            dest->data = dest->inline_data; \
+            dest->capacity = dest->inline_capacity; \
+            return VECTOR_SUCCESS; \
+        } \
+        dest->capacity = src->capacity; \
+        if (src->capacity == 0) { \
+            dest->data = NULL; \
+            return VECTOR_SUCCESS; \
+        } \
+    \
+        dest->data = allocate_data_##suffix(dest, src->capacity); \
+        return dest->data ? VECTOR_SUCCESS : VECTOR_ERROR_MEMORY_ALLOCATION; \
+    } \
+    \
+    static void destroy_elements_##suffix(const Name *v, T *data, size_t size) { \
+        if (!v->trivial && v->DeleteVoidPtr) { \
+            for (size_t i = 0; i < size; i++) { \
+                v->DeleteVoidPtr(data[i]); \
+            } \
+        } \
+    } \
+    \
+    /* \
+     * Empties v, destroying its buffer unless other holders still share it. \
+     * Returns 1 if v was the last holder; v->shared is left for the caller. \
+     */ \
+    static int release_storage_##suffix(Name *v) { \
+        const int last = !v->shared || VECTOR_ATOMIC_FETCH_ADD(v->shared, (size_t)-1) == 1; \
+        if (last && v->data) { \
+            destroy_elements_##suffix(v, v->data, v->size); \
+            if (!is_inline_##suffix(v)) { \
+                release_data_##suffix(v, v->data, v->capacity); \
+            } \
+        } \
+        v->data = NULL; \
+        v->size = 0; \
+        v->capacity = 0; \
+        return last; \
+    } \
+    \
+    VectorStatus detach_##suffix(Name *v) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        if (!v->shared || VECTOR_ATOMIC_LOAD(v->shared) == 1) { \
+            return VECTOR_SUCCESS; \
+        } \
+    \
+        T *own = allocate_data_##suffix(v, v->capacity); \
+        size_t *count = (size_t*)malloc(sizeof(size_t)); \
+        if (!own || !count) { \
+            if (own) { \
+                release_data_##suffix(v, own, v->capacity); \
+            } \
+            free(count); \
+            return VECTOR_ERROR_MEMORY_ALLOCATION; \
+        } \
+        copy_elements_##suffix(v, own, v->data, v->size); \
+    \
+        /* The other holders may have let go while the copy was made. */ \
+        const size_t size = v->size; \
+        const size_t capacity = v->capacity; \
+        if (release_storage_##suffix(v)) { \
+            free(v->shared); \
+        } \
+        *count = 1; \
+        v->shared = count; \
+        v->data = own; \
+        v->size = size; \
+        v->capacity = capacity; \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus erase_##suffix(Name *v) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        /* A vector that shares its buffer needs a count of its own afterwards. */ \
+        size_t *count = NULL; \
+        if (v->shared && VECTOR_ATOMIC_LOAD(v->shared) != 1) { \
+            count = (size_t*)malloc(sizeof(size_t)); \
+            if (!count) { \
+                return VECTOR_ERROR_MEMORY_ALLOCATION; \
+            } \
+            *count = 1; \
+        } \
+    \
+        if (release_storage_##suffix(v)) { \
+            if (v->shared) { \
+                *v->shared = 1; \
+            } \
+            free(count); \
+        } else { \
+            v->shared = count; \
+        } \
+    \
+        if (v->inline_data) { \
+            v->data = v->inline_data; \
+            v->capacity = v->inline_capacity; \
+        } \
+    \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    int is_equal_##suffix(const Name *v1, const Name *v2) { \
+        if (!v1 || !v2) { \
+            return 0; \
+        } \
+        if (v1->size != v2->size) { \
+            return 0; \
+        } \
+        if ((BUILTIN) && VECTOR_IS_TYPE(T, int)) { \
+            return vector_equal_int((const int*)(const void*)v1->data, (const int*)(const void*)v2->data, v1->size); \
+        } \
+        if ((BUILTIN) && VECTOR_IS_TYPE(T, float)) { \
+            return vector_equal_float((const float*)(const void*)v1->data, (const float*)(const void*)v2->data, v1->size); \
+        } \
+    \
+        for (size_t i = 0; i < v1->size; i++) { \
+            if (!EQUAL(v1->data[i], v2->data[i])) { \
+                return 0; \
+            } \
+        } \
+        return 1; \
+    } \
+    \
+    VectorStatus copy_##suffix(Name *dest, const Name *src) { \
+        if (!dest || !src) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        if (dest == src) { \
+            return VECTOR_SUCCESS; \
+        } \
+    \
+        VectorStatus status = erase_##suffix(dest); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+    \
+        dest->size = src->size; \
+        dest->capacity = src->capacity; \
+        dest->CopyVoidPtr = src->CopyVoidPtr; \
+        dest->DeleteVoidPtr = src->DeleteVoidPtr; \
+        dest->trivial = src->trivial; \
+        dest->growth_factor = src->growth_factor; \
+        dest->growth_increment = src->growth_increment; \
+        status = set_copy_on_write_##suffix(dest, src->copy_on_write); \
+        if (status != VECTOR_SUCCESS || allocate_copy_storage_##suffix(dest, src) != VECTOR_SUCCESS) { \
+            dest->capacity = 0; \
+            dest->size = 0; \
+            return VECTOR_ERROR_MEMORY_ALLOCATION; \
+        } \
+    \
+        copy_elements_##suffix(dest, dest->data, src->data, src->size); \
+    \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus copy_##suffix##_new(const Name *src, Name **result) { \
+        if (!src || !result) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        *result = (Name*)malloc(sizeof(Name)); \
+        if (!*result) { \
+            return VECTOR_ERROR_MEMORY_ALLOCATION; \
+        } \
+    \
+        (*result)->size = src->size; \
+        (*result)->capacity = src->capacity; \
+        (*result)->CopyVoidPtr = src->CopyVoidPtr; \
+        (*result)->DeleteVoidPtr = src->DeleteVoidPtr; \
+        (*result)->trivial = src->trivial; \
+        (*result)->growth_factor = src->growth_factor; \
+        (*result)->growth_increment = src->growth_increment; \
+        (*result)->shared = NULL; \
+        (*result)->copy_on_write = src->copy_on_write; \
+        (*result)->allocator = src->allocator; \
+        (*result)->inline_data = NULL; \
+        (*result)->inline_capacity = 0; \
+    \
+        if (src->copy_on_write && src->data && !is_inline_##suffix(src)) { \
+            VECTOR_ATOMIC_FETCH_ADD(src->shared, (size_t)1); \
+            (*result)->data = src->data; \
+            (*result)->shared = src->shared; \
+            return VECTOR_SUCCESS; \
+        } \
+    \
+        if (src->copy_on_write) { \
+            (*result)->shared = (size_t*)malloc(sizeof(size_t)); \
+            if (!(*result)->shared) { \
+                free(*result); \
+                *result = NULL; \
+                return VECTOR_ERROR_MEMORY_ALLOCATION; \
+            } \
+            *(*result)->shared = 1; \
+        } \
+    \
+        if (allocate_copy_storage_##suffix(*result, src) != VECTOR_SUCCESS) { \
+            free((*result)->shared); \
+            free(*result); \
+            *result = NULL; \
+            return VECTOR_ERROR_MEMORY_ALLOCATION; \
+        } \
+    \
+        copy_elements_##suffix(*result, (*result)->data, src->data, src->size); \
+    \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus push_back_##suffix(Name *v, T value) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        VectorStatus status = detach_##suffix(v); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+    \
+        if (v->size >= v->capacity) { \
+            status = grow_##suffix(v, next_capacity_##suffix(v)); \
+            if (status != VECTOR_SUCCESS) { \
+                return status; \
+            } \
+        } \
+    \
+        v->data[v->size] = !v->trivial && v->CopyVoidPtr ? v->CopyVoidPtr(value) : value; \
+        v->size++; \
+    \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus delete_at_##suffix(Name *v, size_t index, T *deleted_value) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        if (v->size == 0) { \
+            return VECTOR_ERROR_EMPTY_VECTOR; \
+        } \
+    \
+        if (index >= v->size) { \
+            return VECTOR_ERROR_INDEX_OUT_OF_BOUNDS; \
+        } \
+    \
+        VectorStatus status = detach_##suffix(v); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+    \
+        if (deleted_value) { \
+            *deleted_value = v->data[index]; \
+        } \
+    \
+        if (!v->trivial && v->DeleteVoidPtr) { \
+            v->DeleteVoidPtr(v->data[index]); \
+        } \
+    \
+        memmove(v->data + index, v->data + index + 1, (v->size - index - 1) * sizeof(T)); \
+        v->size--; \
+    \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus get_at_##suffix(const Name *v, size_t index, T *result) { \
+        if (!v || !result) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        if (index >= v->size) { \
+            return VECTOR_ERROR_INDEX_OUT_OF_BOUNDS; \
+        } \
+    \
+        *result = v->data[index]; \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus delete_##suffix(Name *v) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        if (release_storage_##suffix(v)) { \
+            free(v->shared); \
+        } \
+        v->shared = NULL; \
+        v->copy_on_write = 0; \
+    \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus set_trivial_##suffix(Name *v, int trivial) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        v->trivial = trivial != 0; \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus set_copy_on_write_##suffix(Name *v, int enabled) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        if (enabled && !v->shared) { \
+            v->shared = (size_t*)malloc(sizeof(size_t)); \
+            if (!v->shared) { \
+                return VECTOR_ERROR_MEMORY_ALLOCATION; \
+            } \
+            *v->shared = 1; \
+        } else if (!enabled && v->shared) { \
+            VectorStatus status = detach_##suffix(v); \
+            if (status != VECTOR_SUCCESS) { \
+                return status; \
+            } \
+            free(v->shared); \
+            v->shared = NULL; \
+        } \
+    \
+        v->copy_on_write = enabled != 0; \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus reserve_##suffix(Name *v, size_t capacity) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        if (capacity <= v->capacity) { \
+            return VECTOR_SUCCESS; \
+        } \
+        if (capacity > (size_t)-1 / sizeof(T)) { \
+            return VECTOR_ERROR_INVALID_CAPACITY; \
+        } \
+    \
+        VectorStatus status = detach_##suffix(v); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+    \
+        return grow_##suffix(v, capacity); \
+    } \
+    \
+    VectorStatus shrink_to_fit_##suffix(Name *v) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        if (is_inline_##suffix(v) || v->size == v->capacity) { \
+            return VECTOR_SUCCESS; \
+        } \
+    \
+        VectorStatus status = detach_##suffix(v); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+    \
+        if (v->size == 0) { \
+            release_data_##suffix(v, v->data, v->capacity); \
+            v->data = NULL; \
+            v->capacity = 0; \
+            return VECTOR_SUCCESS; \
+        } \
+    \
+        T *new_data = reallocate_data_##suffix(v, v->size); \
+        if (!new_data) { \
+            return VECTOR_ERROR_MEMORY_ALLOCATION; \
+        } \
+        v->data = new_data; \
+        v->capacity = v->size; \
+    \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus set_growth_policy_##suffix(Name *v, double growth_factor, size_t growth_increment) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        /* NaN and infinity fail the range check as well. */ \
+        if (growth_increment == 0 && \
+            !(growth_factor > 1.0 && growth_factor <= VECTOR_MAX_GROWTH_FACTOR)) { \
+            return VECTOR_ERROR_INVALID_CAPACITY; \
+        } \
+    \
+        v->growth_factor = growth_factor; \
+        v->growth_increment = growth_increment; \
+    \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus append_range_##suffix(Name *v, const T *values, size_t count) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        return insert_range_##suffix(v, v->size, values, count); \
+    } \
+    \
+    VectorStatus insert_range_##suffix(Name *v, size_t index, const T *values, size_t count) { \
+        if (!v || (!values && count > 0)) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        if (index > v->size) { \
+            return VECTOR_ERROR_INDEX_OUT_OF_BOUNDS; \
+        } \
+    \
+        if (count == 0) { \
+            return VECTOR_SUCCESS; \
+        } \
+    \
+        VectorStatus status = detach_##suffix(v); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+    \
+        status = ensure_capacity_##suffix(v, count); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+    \
+        memmove(v->data + index + count, v->data + index, (v->size - index) * sizeof(T)); \
+        copy_elements_##suffix(v, v->data + index, values, count); \
+        v->size += count; \
+    \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus erase_range_##suffix(Name *v, size_t index, size_t count) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        if (index > v->size || count > v->size - index) { \
+            return VECTOR_ERROR_INDEX_OUT_OF_BOUNDS; \
+        } \
+    \
+        if (count == 0) { \
+            return VECTOR_SUCCESS; \
+        } \
+    \
+        VectorStatus status = detach_##suffix(v); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+    \
+        destroy_elements_##suffix(v, v->data + index, count); \
+        memmove(v->data + index, v->data + index + count, (v->size - index - count) * sizeof(T)); \
+        v->size -= count; \
+    \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus swap_remove_##suffix(Name *v, size_t index, T *deleted_value) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        if (v->size == 0) { \
+            return VECTOR_ERROR_EMPTY_VECTOR; \
+        } \
+    \
+        if (index >= v->size) { \
+            return VECTOR_ERROR_INDEX_OUT_OF_BOUNDS; \
+        } \
+    \
+        VectorStatus status = detach_##suffix(v); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+    \
+        if (deleted_value) { \
+            *deleted_value = v->data[index]; \
+        } \
+    \
+        if (!v->trivial && v->DeleteVoidPtr) { \
+            v->DeleteVoidPtr(v->data[index]); \
+        } \
+    \
+        v->size--; \
+        v->data[index] = v->data[v->size]; \
+    \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus remove_if_##suffix(Name *v, int (*predicate)(T, void*), void *context, size_t *removed_count) { \
+        if (!v || !predicate) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        VectorStatus status = detach_##suffix(v); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+    \
+        size_t kept = 0; \
+        for (size_t i = 0; i < v->size; i++) { \
+            if (predicate(v->data[i], context)) { \
+                if (!v->trivial && v->DeleteVoidPtr) { \
+                    v->DeleteVoidPtr(v->data[i]); \
+                } \
+            } else { \
+                v->data[kept++] = v->data[i]; \
+            } \
+        } \
+    \
+        if (removed_count) { \
+            *removed_count = v->size - kept; \
+        } \
+        v->size = kept; \
+    \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus find_##suffix(const Name *v, T value, size_t *index) { \
+        if (!v || !index) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        union { T element; int integer; float real; } needle; \
+        needle.element = value; \
+        if ((BUILTIN) && VECTOR_IS_TYPE(T, int)) { \
+            *index = vector_find_int((const int*)(const void*)v->data, v->size, needle.integer); \
+            return VECTOR_SUCCESS; \
+        } \
+        if ((BUILTIN) && VECTOR_IS_TYPE(T, float)) { \
+            *index = vector_find_float((const float*)(const void*)v->data, v->size, needle.real); \
+            return VECTOR_SUCCESS; \
+        } \
+    \
+        size_t i = 0; \
+        while (i < v->size && !EQUAL(v->data[i], value)) { \
+            i++; \
+        } \
+        *index = i; \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus count_##suffix(const Name *v, T value, size_t *count) { \
+        if (!v || !count) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        union { T element; int integer; float real; } needle; \
+        needle.element = value; \
+        if ((BUILTIN) && VECTOR_IS_TYPE(T, int)) { \
+            *count = vector_count_int((const int*)(const void*)v->data, v->size, needle.integer); \
+            return VECTOR_SUCCESS; \
+        } \
+        if ((BUILTIN) && VECTOR_IS_TYPE(T, float)) { \
+            *count = vector_count_float((const float*)(const void*)v->data, v->size, needle.real); \
+            return VECTOR_SUCCESS; \
+        } \
+    \
+        size_t matches = 0; \
+        for (size_t i = 0; i < v->size; i++) { \
+            if (EQUAL(v->data[i], value)) { \
+                matches++; \
+            } \
+        } \
+        *count = matches; \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    int contains_##suffix(const Name *v, T value) { \
+        size_t index; \
+        return find_##suffix(v, value, &index) == VECTOR_SUCCESS && index < v->size; \
+    } \
+    \
+    static void swap_elements_##suffix(T *data, size_t i, size_t j) { \
+        T temp = data[i]; \
+        data[i] = data[j]; \
+        data[j] = temp; \
+    } \
+    \
+    static void insertion_sort_##suffix(T *data, size_t size) { \
+        for (size_t i = 1; i < size; i++) { \
+            T value = data[i]; \
+            size_t j = i; \
+            while (j > 0 && LESS(value, data[j - 1])) { \
+                data[j] = data[j - 1]; \
+                j--; \
+            } \
+            data[j] = value; \
+        } \
+    } \
+    \
+    static void sift_down_##suffix(T *data, size_t root, size_t size) { \
+        for (size_t child = 2 * root + 1; child < size; child = 2 * root + 1) { \
+            if (child + 1 < size && LESS(data[child], data[child + 1])) { \
+                child++; \
+            } \
+            if (!LESS(data[root], data[child])) { \
+                return; \
+            } \
+            swap_elements_##suffix(data, root, child); \
+            root = child; \
+        } \
+    } \
+    \
+    static void heap_sort_##suffix(T *data, size_t size) { \
+        for (size_t i = size / 2; i > 0; i--) { \
+            sift_down_##suffix(data, i - 1, size); \
+        } \
+        for (size_t end = size - 1; end > 0; end--) { \
+            swap_elements_##suffix(data, 0, end); \
+            sift_down_##suffix(data, 0, end); \
+        } \
+    } \
+    \
+    /* Median-of-three Hoare quicksort, heap sort past depth_limit, insertion sort for small runs. */ \
+    static void introsort_##suffix(T *data, size_t size, int depth_limit) { \
+        while (size > 16) { \
+            if (depth_limit-- == 0) { \
+                heap_sort_##suffix(data, size); \
+                return; \
+            } \
+    \
+            const size_t mid = size / 2; \
+            if (LESS(data[mid], data[0])) { \
+                swap_elements_##suffix(data, 0, mid); \
+            } \
+            if (LESS(data[size - 1], data[mid])) { \
+                swap_elements_##suffix(data, mid, size - 1); \
+                if (LESS(data[mid], data[0])) { \
+                    swap_elements_##suffix(data, 0, mid); \
+                } \
+            } \
+    \
+            T pivot = data[mid]; \
+            size_t i = (size_t)-1; \
+            size_t j = size; \
+            for (;;) { \
+                do { \
+                    i++; \
+                } while (LESS(data[i], pivot)); \
+                do { \
+                    j--; \
+                } while (LESS(pivot, data[j])); \
+                if (i >= j) { \
+                    break; \
+                } \
+                swap_elements_##suffix(data, i, j); \
+            } \
+    \
+            const size_t left = j + 1; \
+            if (left < size - left) { \
+                introsort_##suffix(data, left, depth_limit); \
+                data += left; \
+                size -= left; \
+            } else { \
+                introsort_##suffix(data + left, size - left, depth_limit); \
+                size = left; \
+            } \
+        } \
+        insertion_sort_##suffix(data, size); \
+    } \
+    \
+    VectorStatus sort_##suffix(Name *v) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        VectorStatus status = detach_##suffix(v); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+    \
+        if ((BUILTIN) && v->size >= VECTOR_RADIX_THRESHOLD) { \
+            const int is_signed = VECTOR_IS_SIGNED_INTEGER(T); \
+            if (is_signed || VECTOR_IS_UNSIGNED_INTEGER(T)) { \
+                int sorted = 0; \
+                if (sizeof(T) == sizeof(unsigned short)) { \
+                    sorted = vector_radix_sort_ushort((unsigned short*)(void*)v->data, v->size, is_signed); \
+                } else if (sizeof(T) == sizeof(unsigned int)) { \
+                    sorted = vector_radix_sort_uint((unsigned int*)(void*)v->data, v->size, is_signed); \
+                } else if (sizeof(T) == sizeof(unsigned long long)) { \
+                    sorted = vector_radix_sort_ullong((unsigned long long*)(void*)v->data, v->size, is_signed); \
+                } \
+                if (sorted) { \
+                    return VECTOR_SUCCESS; \
+                } \
+            } \
+        } \
+    \
+        int depth_limit = 0; \
+        for (size_t n = v->size; n > 1; n >>= 1) { \
+            depth_limit += 2; \
+        } \
+        introsort_##suffix(v->data, v->size, depth_limit); \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus lower_bound_##suffix(const Name *v, T value, size_t *index) { \
+        if (!v || !index) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        size_t low = 0; \
+        size_t high = v->size; \
+        while (low < high) { \
+            const size_t mid = low + (high - low) / 2; \
+            if (LESS(v->data[mid], value)) { \
+                low = mid + 1; \
+            } else { \
+                high = mid; \
+            } \
+        } \
+        *index = low; \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus insert_sorted_##suffix(Name *v, T value, size_t *index) { \
+        size_t position; \
+        VectorStatus status = lower_bound_##suffix(v, value, &position); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+    \
+        status = insert_range_##suffix(v, position, &value, 1); \
+        if (status == VECTOR_SUCCESS && index) { \
+            *index = position; \
+        } \
+        return status; \
+    } \
+    \
+    VectorStatus merge_sorted_##suffix(Name *dest, const Name *a, const Name *b) { \
+        if (!dest || !a || !b) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        VectorStatus status = erase_##suffix(dest); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+        dest->CopyVoidPtr = a->CopyVoidPtr; \
+        dest->DeleteVoidPtr = a->DeleteVoidPtr; \
+        dest->trivial = a->trivial; \
+        status = reserve_##suffix(dest, a->size + b->size); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+    \
+        size_t i = 0; \
+        size_t j = 0; \
+        while (i < a->size && j < b->size) { \
+            if (LESS(b->data[j], a->data[i])) { \
+                copy_elements_##suffix(dest, dest->data + dest->size++, b->data + j++, 1); \
+            } else { \
+                copy_elements_##suffix(dest, dest->data + dest->size++, a->data + i++, 1); \
+            } \
+        } \
+        copy_elements_##suffix(dest, dest->data + dest->size, a->data + i, a->size - i); \
+        dest->size += a->size - i; \
+        copy_elements_##suffix(dest, dest->data + dest->size, b->data + j, b->size - j); \
+        dest->size += b->size - j; \
+    \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus save_##suffix(const Name *v, const char *path, VectorEncoding encoding) { \
+        if (!v || !path) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        const int is_signed = (BUILTIN) && VECTOR_IS_SIGNED_INTEGER(T); \
+        const int is_integer = is_signed || ((BUILTIN) && VECTOR_IS_UNSIGNED_INTEGER(T)); \
+        return vector_binary_save(path, v->data, v->size, sizeof(T), encoding, is_integer, is_signed); \
+    } \
+    \
+    /* Empties v and presizes it for the elements about to be read. */ \
+    static void *load_storage_##suffix(void *context, size_t size) { \
+        Name *v = (Name*)context; \
+        if (detach_##suffix(v) != VECTOR_SUCCESS || erase_range_##suffix(v, 0, v->size) != VECTOR_SUCCESS || \
+            reserve_##suffix(v, size) != VECTOR_SUCCESS) { \
+            return NULL; \
+        } \
+        return v->data; \
+    } \
+    \
+    VectorStatus load_##suffix(Name *v, const char *path) { \
+        if (!v || !path) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        size_t size = 0; \
+        VectorStatus status = vector_binary_load(path, sizeof(T), load_storage_##suffix, v, &size); \
+        if (status == VECTOR_SUCCESS) { \
+            v->size = size; \
+        } \
+        return status; \
+    }
+
+/*
+ * Small-buffer vector template over an instantiated Base vector:
+ * DECLARE_SMALL_VECTOR(Name, suffix, Base, T, N) bundles Base with inline
+ * storage for N elements, and create_<suffix> sets it up so the Base API
+ * (push_back_<base_suffix>(&small.vector, ...)) uses that storage until the
+ * vector outgrows it. The vector points into its own struct, so it must not
+ * be moved with a struct copy. Heap-only vectors carry no inline storage.
+ */
+#define DECLARE_SMALL_VECTOR(Name, suffix, Base, T, N) \
+    typedef struct { \
+        Base vector; \
+        T storage[N]; \
+    } Name; \
+    \
+    VectorStatus create_##suffix(Name *small, T (*CopyFunc)(T), void (*DeleteFunc)(T));
+
+#define DEFINE_SMALL_VECTOR(Name, suffix, base_suffix, T, N) \
+    VectorStatus create_##suffix(Name *small, T (*CopyFunc)(T), void (*DeleteFunc)(T)) { \
+        if (!small) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        return create_inline_##base_suffix(&small->vector, small->storage, (N), CopyFunc, DeleteFunc); \
+    }
+
+/*
+ * Concurrent append-only vector template. Producers reserve a slot with one
+ * atomic fetch-add and write it into segmented storage: segment k holds
+ * VECTOR_FIRST_SEGMENT << k slots and is never moved once published, so
+ * indices stay stable. Each slot carries a ready flag that its producer sets
+ * after writing the value, so no producer waits on another. size_<suffix>
+ * counts reserved slots, some of which may still be in flight;
+ * get_at_<suffix> returns VECTOR_ERROR_NOT_READY for those. A push_back that
+ * fails to allocate its segment leaves its slot never ready, and later
+ * appends retry the allocation. create and delete are not thread-safe.
+ */
+#define VECTOR_FIRST_SEGMENT_BITS 6
+#define VECTOR_FIRST_SEGMENT ((size_t)1 << VECTOR_FIRST_SEGMENT_BITS)
+#define VECTOR_MAX_SEGMENTS (sizeof(size_t) * 8 - VECTOR_FIRST_SEGMENT_BITS)
+
+/* Segment holding index, with the position inside it stored in *offset. */
+size_t vector_segment_of(size_t index, size_t *offset);
+
+#if defined(__GNUC__)
+#define VECTOR_ATOMIC_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define VECTOR_ATOMIC_STORE(p, value) __atomic_store_n((p), (value), __ATOMIC_RELEASE)
+#define VECTOR_ATOMIC_FETCH_ADD(p, value) __atomic_fetch_add((p), (value), __ATOMIC_ACQ_REL)
+#define VECTOR_ATOMIC_PUBLISH(p, expected, value) \
+    __atomic_compare_exchange_n((p), (expected), (value), 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#else
+/* Without GCC-style atomics the concurrent vector is only safe from one thread. */
+#define VECTOR_ATOMIC_LOAD(p) (*(p))
+#define VECTOR_ATOMIC_STORE(p, value) (*(p) = (value))
+#define VECTOR_ATOMIC_FETCH_ADD(p, value) ((*(p) += (value)) - (value))
+#define VECTOR_ATOMIC_PUBLISH(p, expected, value) (*(p) == *(expected) ? (*(p) = (value), 1) : (*(expected) = *(p), 0))
+#endif
+
+#define DECLARE_CONCURRENT_VECTOR(Name, suffix, T) \
+    typedef struct { \
+        T value; \
+        int ready; \
+    } Name##Slot; \
+    \
+    typedef struct { \
+        Name##Slot *segments[VECTOR_MAX_SEGMENTS]; \
+        size_t reserved; \
+    } Name; \
+    \
+    VectorStatus create_##suffix(Name *v); \
+    VectorStatus reserve_##suffix(Name *v, size_t capacity); \
+    VectorStatus push_back_##suffix(Name *v, T value, size_t *index); \
+    VectorStatus get_at_##suffix(const Name *v, size_t index, T *result); \
+    size_t size_##suffix(const Name *v); \
+    VectorStatus delete_##suffix(Name *v);
+
+#define DEFINE_CONCURRENT_VECTOR(Name, suffix, T) \
+    VectorStatus create_##suffix(Name *v) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        for (size_t k = 0; k < VECTOR_MAX_SEGMENTS; k++) { \
+            v->segments[k] = NULL; \
+        } \
+        v->reserved = 0; \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    /* Returns segment k, allocating and publishing it if no thread has yet. */ \
+    static Name##Slot *segment_##suffix(Name *v, size_t k) { \
+        Name##Slot *segment = VECTOR_ATOMIC_LOAD(&v->segments[k]); \
+        if (segment) { \
+            return segment; \
+        } \
+    \
+        Name##Slot *fresh = (Name##Slot*)calloc(VECTOR_FIRST_SEGMENT << k, sizeof(Name##Slot)); \
+        if (!fresh) { \
+            return NULL; \
+        } \
+        if (!VECTOR_ATOMIC_PUBLISH(&v->segments[k], &segment, fresh)) { \
+            free(fresh); \
+            return segment; \
+        } \
+        return fresh; \
+    } \
+    \
+    VectorStatus reserve_##suffix(Name *v, size_t capacity) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        if (capacity == 0) { \
+            return VECTOR_SUCCESS; \
+        } \
+        size_t offset; \
+        const size_t last = vector_segment_of(capacity - 1, &offset); \
+        for (size_t k = 0; k <= last; k++) { \
+            if (!segment_##suffix(v, k)) { \
+                return VECTOR_ERROR_MEMORY_ALLOCATION; \
+            } \
+        } \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus push_back_##suffix(Name *v, T value, size_t *index) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        const size_t slot = VECTOR_ATOMIC_FETCH_ADD(&v->reserved, (size_t)1); \
+        size_t offset; \
+        Name##Slot *segment = segment_##suffix(v, vector_segment_of(slot, &offset)); \
+        if (!segment) { \
+            return VECTOR_ERROR_MEMORY_ALLOCATION; \
+        } \
+        segment[offset].value = value; \
+        VECTOR_ATOMIC_STORE(&segment[offset].ready, 1); \
+    \
+        if (index) { \
+            *index = slot; \
+        } \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus get_at_##suffix(const Name *v, size_t index, T *result) { \
+        if (!v || !result) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        if (index >= VECTOR_ATOMIC_LOAD(&v->reserved)) { \
+            return VECTOR_ERROR_INDEX_OUT_OF_BOUNDS; \
+        } \
+        size_t offset; \
+        const size_t k = vector_segment_of(index, &offset); \
+        const Name##Slot *segment = VECTOR_ATOMIC_LOAD(&v->segments[k]); \
+        if (!segment || !VECTOR_ATOMIC_LOAD(&segment[offset].ready)) { \
+            return VECTOR_ERROR_NOT_READY; \
+        } \
+        *result = segment[offset].value; \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    size_t size_##suffix(const Name *v) { \
+        return v ? VECTOR_ATOMIC_LOAD(&v->reserved) : 0; \
+    } \
+    \
+    VectorStatus delete_##suffix(Name *v) { \
+        if (!v) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        for (size_t k = 0; k < VECTOR_MAX_SEGMENTS; k++) { \
+            free(v->segments[k]); \
+            v->segments[k] = NULL; \
+        } \
+        v->reserved = 0; \
+        return VECTOR_SUCCESS; \
+    }
+
+/*
+ * File-backed vector template for element types that can be stored as raw
+ * bytes. The file starts with a VECTOR_FILE_HEADER_SIZE-byte header recording
+ * element size, size and capacity, followed by the elements; the whole file
+ * is mapped shared and data points into the mapping, so reopening an existing
+ * file is a warm start with nothing to parse. Growth extends the file with
+ * ftruncate and remaps it (mremap where available), which may move data.
+ * sync_<suffix> flushes the mapping to disk; close_<suffix> unmaps it and
+ * leaves the file in place.
+ */
+#define VECTOR_FILE_MAGIC "N2VECTOR"
+#define VECTOR_FILE_VERSION 1u
+#define VECTOR_FILE_HEADER_SIZE 64
+#define VECTOR_MAPPED_INITIAL_CAPACITY 1024
+
+typedef struct {
+    char magic[8];
+    unsigned int version;
+    unsigned int element_size;
+    unsigned long long size;
+    unsigned long long capacity;
+} VectorFileHeader;
+
+typedef struct {
+    int fd;
+    void *base;
+    size_t bytes;
+} VectorMapping;
+
+/*
+ * Opens or creates the file at path and maps it. An existing file must carry
+ * a valid header for element_size, otherwise VECTOR_ERROR_INVALID_FILE.
+ */
+VectorStatus vector_mapping_open(VectorMapping *mapping, const char *path, size_t element_size);
+/* Grows the file and mapping to hold capacity elements and records it in the header. */
+VectorStatus vector_mapping_reserve(VectorMapping *mapping, size_t capacity);
+VectorStatus vector_mapping_sync(VectorMapping *mapping);
+VectorStatus vector_mapping_close(VectorMapping *mapping);
+
+#define DECLARE_MAPPED_VECTOR(Name, suffix, T) \
+    typedef struct { \
+        T *data; \
+        size_t size; \
+        size_t capacity; \
+        VectorFileHeader *header; \
+        VectorMapping mapping; \
+    } Name; \
+    \
+    VectorStatus open_##suffix(Name *v, const char *path); \
+    VectorStatus reserve_##suffix(Name *v, size_t capacity); \
+    VectorStatus push_back_##suffix(Name *v, T value); \
+    VectorStatus append_range_##suffix(Name *v, const T *values, size_t count); \
+    VectorStatus get_at_##suffix(const Name *v, size_t index, T *result); \
+    VectorStatus erase_##suffix(Name *v); \
+    VectorStatus sync_##suffix(Name *v); \
+    VectorStatus close_##suffix(Name *v);
+
+#define DEFINE_MAPPED_VECTOR(Name, suffix, T) \
+    /* Points the struct at the current mapping after it was opened or moved. */ \
+    static void bind_##suffix(Name *v) { \
+        v->header = (VectorFileHeader*)v->mapping.base; \
+        v->data = (T*)(void*)((unsigned char*)v->mapping.base + VECTOR_FILE_HEADER_SIZE); \
+        v->size = (size_t)v->header->size; \
+        v->capacity = (size_t)v->header->capacity; \
+    } \
+    \
+    VectorStatus open_##suffix(Name *v, const char *path) { \
+        if (!v || !path) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        v->data = NULL; \
+        v->size = 0; \
+        v->capacity = 0; \
+        v->header = NULL; \
+        VectorStatus status = vector_mapping_open(&v->mapping, path, sizeof(T)); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+    \
+        bind_##suffix(v); \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus reserve_##suffix(Name *v, size_t capacity) { \
+        if (!v || !v->header) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        if (capacity <= v->capacity) { \
+            return VECTOR_SUCCESS; \
+        } \
+    \
+        VectorStatus status = vector_mapping_reserve(&v->mapping, capacity); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+    \
+        bind_##suffix(v); \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    static VectorStatus ensure_capacity_##suffix(Name *v, size_t count) { \
+        if (count > (size_t)-1 - v->size) { \
+            return VECTOR_ERROR_INVALID_CAPACITY; \
+        } \
+    \
+        const size_t needed = v->size + count; \
+        if (needed <= v->capacity) { \
+            return VECTOR_SUCCESS; \
+        } \
+    \
+        size_t next = v->capacity > 0 ? v->capacity * 2 : VECTOR_MAPPED_INITIAL_CAPACITY; \
+        if (next < needed) { \
+            next = needed; \
+        } \
+        return reserve_##suffix(v, next); \
+    } \
+    \
+    VectorStatus push_back_##suffix(Name *v, T value) { \
+        return append_range_##suffix(v, &value, 1); \
+    } \
+    \
+    VectorStatus append_range_##suffix(Name *v, const T *values, size_t count) { \
+        if (!v || !v->header || (!values && count > 0)) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        VectorStatus status = ensure_capacity_##suffix(v, count); \
+        if (status != VECTOR_SUCCESS) { \
+            return status; \
+        } \
+    \
+        if (count > 0) { \
+            memcpy(v->data + v->size, values, count * sizeof(T)); \
+        } \
+        v->size += count; \
+        v->header->size = v->size; \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus get_at_##suffix(const Name *v, size_t index, T *result) { \
+        if (!v || !result) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        if (index >= v->size) { \
+            return VECTOR_ERROR_INDEX_OUT_OF_BOUNDS; \
+        } \
+    \
+        *result = v->data[index]; \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus erase_##suffix(Name *v) { \
+        if (!v || !v->header) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        v->size = 0; \
+        v->header->size = 0; \
+        return VECTOR_SUCCESS; \
+    } \
+    \
+    VectorStatus sync_##suffix(Name *v) { \
+        if (!v || !v->header) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        return vector_mapping_sync(&v->mapping); \
+    } \
+    \
+    VectorStatus close_##suffix(Name *v) { \
+        if (!v || !v->header) { \
+            return VECTOR_ERROR_NULL_POINTER; \
+        } \
+    \
+        VectorStatus status = vector_mapping_close(&v->mapping); \
+        v->data = NULL; \
+        v->size = 0; \
+        v->capacity = 0; \
+        v->header = NULL; \
+        return status; \
+    }
+
+/*
+ * The default instantiations for VECTOR_TYPE: the *_vector, *_small_vector,
+ * *_concurrent_vector and *_mapped_vector APIs.
+ */
+DECLARE_VECTOR(Vector, vector, VECTOR_TYPE)
+DECLARE_SMALL_VECTOR(SmallVector, small_vector, Vector, VECTOR_TYPE, VECTOR_INLINE_CAPACITY)
+DECLARE_CONCURRENT_VECTOR(ConcurrentVector, concurrent_vector, VECTOR_TYPE)
+DECLARE_MAPPED_VECTOR(MappedVector, mapped_vector, VECTOR_TYPE)
 
 #endif
\ No newline at end of file
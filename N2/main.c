@@ -18,6 +18,7 @@ int main() {
         printf("Error creating vector: %s\n", vector_status_string(status));
         return 1;
     }
+    set_trivial_vector(&vec, 1);
     
     for (int i = 0; i < 5; i++) {
         status = push_back_vector(&vec, i * 10);
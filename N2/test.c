@@ -2,8 +2,36 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <pthread.h>
 #include "functions.h"
 
+typedef struct {
+    int x;
+    int y;
+} Point;
+
+#define POINT_EQUAL(a, b) ((a).x == (b).x && (a).y == (b).y)
+#define POINT_LESS(a, b) ((a).x < (b).x || ((a).x == (b).x && (a).y < (b).y))
+
+DECLARE_VECTOR(DoubleVector, double_vector, double)
+DEFINE_VECTOR(DoubleVector, double_vector, double)
+DECLARE_VECTOR(StringVector, string_vector, const char*)
+DEFINE_VECTOR(StringVector, string_vector, const char*)
+DECLARE_SMALL_VECTOR(SmallStringVector, small_string_vector, StringVector, const char*, 4)
+DEFINE_SMALL_VECTOR(SmallStringVector, small_string_vector, string_vector, const char*, 4)
+DECLARE_VECTOR(FloatVector, float_vector, float)
+DEFINE_VECTOR(FloatVector, float_vector, float)
+DECLARE_VECTOR(LongLongVector, long_long_vector, long long)
+DEFINE_VECTOR(LongLongVector, long_long_vector, long long)
+DECLARE_VECTOR(LongVector, long_vector, long)
+DEFINE_VECTOR(LongVector, long_vector, long)
+DECLARE_VECTOR(UShortVector, ushort_vector, unsigned short)
+DEFINE_VECTOR(UShortVector, ushort_vector, unsigned short)
+DECLARE_VECTOR(SizeVector, size_vector, size_t)
+DEFINE_VECTOR(SizeVector, size_vector, size_t)
+DECLARE_VECTOR(PointVector, point_vector, Point)
+DEFINE_VECTOR_WITH(PointVector, point_vector, Point, POINT_EQUAL, POINT_LESS)
+
 int copy_int(int value) {
     return value;
 }
@@ -844,6 +872,1139 @@ void test_zero_and_negative() {
     printf("PASSED\n");
 }
 
+void test_small_vector() {
+    printf("Testing small-buffer vector... ");
+    
+    SmallVector small;
+    VectorStatus status = create_small_vector(&small, copy_int, delete_int);
+    assert(status == VECTOR_SUCCESS);
+    assert(is_inline_vector(&small.vector));
+    assert(small.vector.capacity == VECTOR_INLINE_CAPACITY);
+    assert(small.vector.size == 0);
+    
+    for (int i = 0; i < VECTOR_INLINE_CAPACITY; i++) {
+        status = push_back_vector(&small.vector, i * 3);
+        assert(status == VECTOR_SUCCESS);
+    }
+    assert(is_inline_vector(&small.vector));
+    
+    Vector *vec_copy;
+    status = copy_vector_new(&small.vector, &vec_copy);
+    assert(status == VECTOR_SUCCESS);
+    assert(!is_inline_vector(vec_copy));
+    assert(vec_copy->data != small.vector.data);
+    assert(is_equal_vector(&small.vector, vec_copy));
+    
+    status = push_back_vector(&small.vector, 100);
+    assert(status == VECTOR_SUCCESS);
+    assert(!is_inline_vector(&small.vector));
+    assert(small.vector.capacity > VECTOR_INLINE_CAPACITY);
+    assert(small.vector.size == VECTOR_INLINE_CAPACITY + 1);
+    
+    int value;
+    for (int i = 0; i < VECTOR_INLINE_CAPACITY; i++) {
+        status = get_at_vector(&small.vector, (size_t)i, &value);
+        assert(status == VECTOR_SUCCESS);
+        assert(value == i * 3);
+    }
+    status = get_at_vector(&small.vector, VECTOR_INLINE_CAPACITY, &value);
+    assert(status == VECTOR_SUCCESS);
+    assert(value == 100);
+    
+    status = delete_at_vector(vec_copy, 0, &value);
+    assert(status == VECTOR_SUCCESS);
+    assert(value == 0);
+    assert(vec_copy->size == VECTOR_INLINE_CAPACITY - 1);
+    
+    Vector vec2;
+    status = create_vector(&vec2, 0, NULL, NULL);
+    assert(status == VECTOR_SUCCESS);
+    status = copy_vector(&vec2, vec_copy);
+    assert(status == VECTOR_SUCCESS);
+    assert(!is_inline_vector(&vec2));
+    assert(is_equal_vector(&vec2, vec_copy));
+    
+    SmallVector small2;
+    status = create_small_vector(&small2, NULL, NULL);
+    assert(status == VECTOR_SUCCESS);
+    status = copy_vector(&small2.vector, vec_copy);
+    assert(status == VECTOR_SUCCESS);
+    assert(is_inline_vector(&small2.vector));
+    assert(is_equal_vector(&small2.vector, vec_copy));
+    status = copy_vector(&small2.vector, &small.vector);
+    assert(status == VECTOR_SUCCESS);
+    assert(!is_inline_vector(&small2.vector));
+    assert(is_equal_vector(&small2.vector, &small.vector));
+    
+    status = erase_vector(&small.vector);
+    assert(status == VECTOR_SUCCESS);
+    assert(is_inline_vector(&small.vector));
+    assert(small.vector.capacity == VECTOR_INLINE_CAPACITY);
+    for (int i = 0; i < VECTOR_INLINE_CAPACITY; i++) {
+        status = push_back_vector(&small.vector, i);
+        assert(status == VECTOR_SUCCESS);
+    }
+    assert(is_inline_vector(&small.vector));
+    status = push_back_vector(&small.vector, VECTOR_INLINE_CAPACITY);
+    assert(status == VECTOR_SUCCESS);
+    assert(!is_inline_vector(&small.vector));
+    status = get_at_vector(&small.vector, 0, &value);
+    assert(status == VECTOR_SUCCESS && value == 0);
+    
+    delete_vector(&small.vector);
+    delete_vector(&small2.vector);
+    delete_vector(&vec2);
+    delete_vector(vec_copy);
+    free(vec_copy);
+    assert(small.vector.data == NULL);
+    assert(vec2.data == NULL);
+    
+    Vector heap;
+    status = create_vector(&heap, 0, NULL, NULL);
+    assert(status == VECTOR_SUCCESS);
+    assert(heap.inline_data == NULL);
+    assert(!is_inline_vector(&heap));
+    delete_vector(&heap);
+    
+    int storage[2];
+    status = create_inline_vector(&heap, storage, 0, NULL, NULL);
+    assert(status == VECTOR_ERROR_INVALID_CAPACITY);
+    status = create_small_vector(NULL, NULL, NULL);
+    assert(status == VECTOR_ERROR_NULL_POINTER);
+    
+    printf("PASSED\n");
+}
+
+void test_capacity_management() {
+    printf("Testing reserve, shrink_to_fit and growth policy... ");
+    
+    Vector vec;
+    VectorStatus status = create_vector(&vec, 0, NULL, NULL);
+    assert(status == VECTOR_SUCCESS);
+    
+    status = reserve_vector(&vec, 1000);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.capacity == 1000);
+    int *reserved = vec.data;
+    for (int i = 0; i < 1000; i++) {
+        status = push_back_vector(&vec, i);
+        assert(status == VECTOR_SUCCESS);
+    }
+    assert(vec.data == reserved);
+    assert(vec.capacity == 1000);
+    
+    status = reserve_vector(&vec, 10);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.capacity == 1000);
+    
+    status = push_back_vector(&vec, 1000);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.capacity == 2000);
+    
+    status = shrink_to_fit_vector(&vec);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.capacity == 1001);
+    int value;
+    status = get_at_vector(&vec, 1000, &value);
+    assert(status == VECTOR_SUCCESS);
+    assert(value == 1000);
+    delete_vector(&vec);
+    
+    status = create_vector(&vec, 4, NULL, NULL);
+    assert(status == VECTOR_SUCCESS);
+    status = set_growth_policy_vector(&vec, 1.5, 0);
+    assert(status == VECTOR_SUCCESS);
+    for (int i = 0; i < 5; i++) {
+        push_back_vector(&vec, i);
+    }
+    assert(vec.capacity == 6);
+    
+    status = set_growth_policy_vector(&vec, 0.0, 10);
+    assert(status == VECTOR_SUCCESS);
+    for (int i = 0; i < 2; i++) {
+        push_back_vector(&vec, i);
+    }
+    assert(vec.capacity == 16);
+    
+    status = set_growth_policy_vector(&vec, 1.0, 0);
+    assert(status == VECTOR_ERROR_INVALID_CAPACITY);
+    volatile double zero = 0.0;
+    status = set_growth_policy_vector(&vec, 1.0 / zero, 0);
+    assert(status == VECTOR_ERROR_INVALID_CAPACITY);
+    status = set_growth_policy_vector(&vec, zero / zero, 0);
+    assert(status == VECTOR_ERROR_INVALID_CAPACITY);
+    status = set_growth_policy_vector(&vec, VECTOR_MAX_GROWTH_FACTOR * 2.0, 0);
+    assert(status == VECTOR_ERROR_INVALID_CAPACITY);
+    assert(vec.growth_increment == 10);
+    status = set_growth_policy_vector(NULL, 2.0, 0);
+    assert(status == VECTOR_ERROR_NULL_POINTER);
+    
+    while (vec.size > 0) {
+        delete_at_vector(&vec, 0, NULL);
+    }
+    status = shrink_to_fit_vector(&vec);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.data == NULL);
+    assert(vec.capacity == 0);
+    delete_vector(&vec);
+    
+    SmallVector small;
+    status = create_small_vector(&small, NULL, NULL);
+    assert(status == VECTOR_SUCCESS);
+    push_back_vector(&small.vector, 7);
+    status = reserve_vector(&small.vector, 100);
+    assert(status == VECTOR_SUCCESS);
+    assert(!is_inline_vector(&small.vector));
+    status = get_at_vector(&small.vector, 0, &value);
+    assert(status == VECTOR_SUCCESS);
+    assert(value == 7);
+    delete_vector(&small.vector);
+    
+    assert(reserve_vector(NULL, 10) == VECTOR_ERROR_NULL_POINTER);
+    assert(shrink_to_fit_vector(NULL) == VECTOR_ERROR_NULL_POINTER);
+    
+    printf("PASSED\n");
+}
+
+static int deleted_count = 0;
+
+void count_delete_int(int value) {
+    (void)value;
+    deleted_count++;
+}
+
+void test_range_operations() {
+    printf("Testing append, insert and erase ranges... ");
+    
+    const int first[] = {1, 2, 3, 4, 5};
+    const int middle[] = {10, 20, 30};
+    const int expected_insert[] = {1, 2, 10, 20, 30, 3, 4, 5};
+    const int expected_erase[] = {1, 30, 3, 4, 5};
+    
+    Vector vec;
+    VectorStatus status = create_vector(&vec, 0, NULL, NULL);
+    assert(status == VECTOR_SUCCESS);
+    
+    status = append_range_vector(&vec, first, 5);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.size == 5);
+    assert(vec.capacity >= 5);
+    
+    status = insert_range_vector(&vec, 2, middle, 3);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.size == 8);
+    assert(memcmp(vec.data, expected_insert, sizeof(expected_insert)) == 0);
+    
+    status = erase_range_vector(&vec, 1, 3);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.size == 5);
+    assert(memcmp(vec.data, expected_erase, sizeof(expected_erase)) == 0);
+    
+    status = insert_range_vector(&vec, 6, middle, 3);
+    assert(status == VECTOR_ERROR_INDEX_OUT_OF_BOUNDS);
+    status = erase_range_vector(&vec, 3, 3);
+    assert(status == VECTOR_ERROR_INDEX_OUT_OF_BOUNDS);
+    status = append_range_vector(&vec, NULL, 1);
+    assert(status == VECTOR_ERROR_NULL_POINTER);
+    status = append_range_vector(&vec, NULL, 0);
+    assert(status == VECTOR_SUCCESS);
+    status = erase_range_vector(&vec, 5, 0);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.size == 5);
+    
+    status = erase_range_vector(&vec, 0, vec.size);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.size == 0);
+    delete_vector(&vec);
+    
+    SmallVector small;
+    status = create_small_vector(&small, copy_int, count_delete_int);
+    assert(status == VECTOR_SUCCESS);
+    status = append_range_vector(&small.vector, first, 5);
+    assert(status == VECTOR_SUCCESS);
+    assert(is_inline_vector(&small.vector));
+    status = append_range_vector(&small.vector, expected_insert, 8);
+    assert(status == VECTOR_SUCCESS);
+    assert(!is_inline_vector(&small.vector));
+    assert(small.vector.size == 13);
+    assert(memcmp(small.vector.data + 5, expected_insert, sizeof(expected_insert)) == 0);
+    
+    deleted_count = 0;
+    status = erase_range_vector(&small.vector, 2, 4);
+    assert(status == VECTOR_SUCCESS);
+    assert(deleted_count == 4);
+    assert(small.vector.size == 9);
+    int value;
+    get_at_vector(&small.vector, 2, &value);
+    assert(value == 2);
+    delete_vector(&small.vector);
+    
+    assert(append_range_vector(NULL, first, 5) == VECTOR_ERROR_NULL_POINTER);
+    assert(erase_range_vector(NULL, 0, 0) == VECTOR_ERROR_NULL_POINTER);
+    
+    printf("PASSED\n");
+}
+
+int is_multiple_of(int value, void *context) {
+    return value % *(int*)context == 0;
+}
+
+void test_unordered_removal() {
+    printf("Testing swap_remove and remove_if... ");
+    
+    const int values[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    Vector vec;
+    VectorStatus status = create_vector(&vec, 0, copy_int, count_delete_int);
+    assert(status == VECTOR_SUCCESS);
+    append_range_vector(&vec, values, 10);
+    
+    int value;
+    status = swap_remove_vector(&vec, 0, &value);
+    assert(status == VECTOR_SUCCESS);
+    assert(value == 0);
+    assert(vec.size == 9);
+    get_at_vector(&vec, 0, &value);
+    assert(value == 9);
+    
+    status = swap_remove_vector(&vec, vec.size - 1, &value);
+    assert(status == VECTOR_SUCCESS);
+    assert(value == 8);
+    assert(vec.size == 8);
+    
+    status = swap_remove_vector(&vec, 8, NULL);
+    assert(status == VECTOR_ERROR_INDEX_OUT_OF_BOUNDS);
+    
+    const int expected[] = {1, 5, 7};
+    int divisor = 2;
+    size_t removed = 0;
+    deleted_count = 0;
+    status = remove_if_vector(&vec, is_multiple_of, &divisor, &removed);
+    assert(status == VECTOR_SUCCESS);
+    assert(removed == 3);
+    assert(deleted_count == 3);
+    divisor = 3;
+    status = remove_if_vector(&vec, is_multiple_of, &divisor, NULL);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.size == 3);
+    assert(memcmp(vec.data, expected, sizeof(expected)) == 0);
+    
+    delete_vector(&vec);
+    
+    status = swap_remove_vector(&vec, 0, NULL);
+    assert(status == VECTOR_ERROR_EMPTY_VECTOR);
+    assert(remove_if_vector(&vec, NULL, NULL, NULL) == VECTOR_ERROR_NULL_POINTER);
+    assert(swap_remove_vector(NULL, 0, NULL) == VECTOR_ERROR_NULL_POINTER);
+    
+    printf("PASSED\n");
+}
+
+void test_vector_template() {
+    printf("Testing DEFINE_VECTOR instantiations... ");
+    
+    DoubleVector doubles;
+    VectorStatus status = create_double_vector(&doubles, 0, NULL, NULL);
+    assert(status == VECTOR_SUCCESS);
+    for (int i = 0; i < 20; i++) {
+        status = push_back_double_vector(&doubles, i * 0.5);
+        assert(status == VECTOR_SUCCESS);
+    }
+    double number;
+    status = get_at_double_vector(&doubles, 19, &number);
+    assert(status == VECTOR_SUCCESS);
+    assert(number == 9.5);
+    
+    DoubleVector *doubles_copy;
+    status = copy_double_vector_new(&doubles, &doubles_copy);
+    assert(status == VECTOR_SUCCESS);
+    assert(is_equal_double_vector(&doubles, doubles_copy));
+    delete_double_vector(doubles_copy);
+    free(doubles_copy);
+    delete_double_vector(&doubles);
+    
+    const char *names[] = {"alpha", "beta", "gamma"};
+    SmallStringVector strings;
+    status = create_small_string_vector(&strings, NULL, NULL);
+    assert(status == VECTOR_SUCCESS);
+    assert(strings.vector.capacity == 4);
+    status = append_range_string_vector(&strings.vector, names, 3);
+    assert(status == VECTOR_SUCCESS);
+    assert(is_inline_string_vector(&strings.vector));
+    const char *name;
+    status = swap_remove_string_vector(&strings.vector, 0, &name);
+    assert(status == VECTOR_SUCCESS);
+    assert(strcmp(name, "alpha") == 0);
+    assert(strcmp(strings.vector.data[0], "gamma") == 0);
+    delete_string_vector(&strings.vector);
+    
+    const Point points[] = {{1, 2}, {3, 4}, {5, 6}};
+    PointVector first;
+    PointVector second;
+    create_point_vector(&first, 0, NULL, NULL);
+    create_point_vector(&second, 0, NULL, NULL);
+    append_range_point_vector(&first, points, 3);
+    append_range_point_vector(&second, points, 3);
+    assert(is_equal_point_vector(&first, &second));
+    second.data[1].y = 0;
+    assert(!is_equal_point_vector(&first, &second));
+    Point point;
+    status = get_at_point_vector(&first, 2, &point);
+    assert(status == VECTOR_SUCCESS);
+    assert(point.x == 5 && point.y == 6);
+    delete_point_vector(&first);
+    delete_point_vector(&second);
+    
+    printf("PASSED\n");
+}
+
+static int copied_count = 0;
+
+int count_copy_int(int value) {
+    copied_count++;
+    return value;
+}
+
+void test_trivial_vector() {
+    printf("Testing trivially copyable vectors... ");
+    
+    const int values[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    Vector vec;
+    VectorStatus status = create_vector(&vec, 0, NULL, NULL);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.trivial);
+    delete_vector(&vec);
+    
+    status = create_vector(&vec, 0, count_copy_int, count_delete_int);
+    assert(status == VECTOR_SUCCESS);
+    assert(!vec.trivial);
+    copied_count = 0;
+    append_range_vector(&vec, values, 10);
+    assert(copied_count == 10);
+    
+    status = set_trivial_vector(&vec, 1);
+    assert(status == VECTOR_SUCCESS);
+    copied_count = 0;
+    deleted_count = 0;
+    push_back_vector(&vec, 11);
+    append_range_vector(&vec, values, 10);
+    
+    Vector *vec_copy;
+    status = copy_vector_new(&vec, &vec_copy);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec_copy->trivial);
+    assert(is_equal_vector(&vec, vec_copy));
+    delete_at_vector(&vec, 0, NULL);
+    erase_range_vector(&vec, 0, 5);
+    delete_vector(&vec);
+    delete_vector(vec_copy);
+    free(vec_copy);
+    assert(copied_count == 0);
+    assert(deleted_count == 0);
+    
+    status = create_vector(&vec, 0, count_copy_int, count_delete_int);
+    assert(status == VECTOR_SUCCESS);
+    append_range_vector(&vec, values, 3);
+    set_trivial_vector(&vec, 1);
+    set_trivial_vector(&vec, 0);
+    deleted_count = 0;
+    delete_vector(&vec);
+    assert(deleted_count == 3);
+    
+    assert(set_trivial_vector(NULL, 1) == VECTOR_ERROR_NULL_POINTER);
+    
+    printf("PASSED\n");
+}
+
+void test_search_vector() {
+    printf("Testing find, count and SIMD equality... ");
+    
+    for (int simd = 0; simd <= 1; simd++) {
+        set_vector_simd(simd);
+        for (size_t size = 0; size <= 40; size++) {
+            Vector vec;
+            create_vector(&vec, 0, NULL, NULL);
+            for (size_t i = 0; i < size; i++) {
+                push_back_vector(&vec, (int)(i % 5));
+            }
+            
+            for (int needle = 0; needle <= 5; needle++) {
+                size_t index;
+                size_t count;
+                size_t expected_index = size;
+                size_t expected_count = 0;
+                for (size_t i = 0; i < size; i++) {
+                    if (vec.data[i] == needle) {
+                        expected_count++;
+                        if (expected_index == size) {
+                            expected_index = i;
+                        }
+                    }
+                }
+                assert(find_vector(&vec, needle, &index) == VECTOR_SUCCESS);
+                assert(index == expected_index);
+                assert(count_vector(&vec, needle, &count) == VECTOR_SUCCESS);
+                assert(count == expected_count);
+                assert(contains_vector(&vec, needle) == (expected_count > 0));
+            }
+            
+            Vector *vec_copy;
+            copy_vector_new(&vec, &vec_copy);
+            assert(is_equal_vector(&vec, vec_copy));
+            if (size > 0) {
+                vec_copy->data[size - 1] = 99;
+                assert(!is_equal_vector(&vec, vec_copy));
+                vec_copy->data[size - 1] = vec.data[size - 1];
+                vec_copy->data[0] = -1;
+                assert(!is_equal_vector(&vec, vec_copy));
+            }
+            delete_vector(vec_copy);
+            free(vec_copy);
+            delete_vector(&vec);
+        }
+    }
+    
+    volatile float zero = 0.0f;
+    const float not_a_number = zero / zero;
+    const float values[] = {1.5f, -0.0f, 2.5f, 1.5f, not_a_number, 3.0f, 1.5f, 4.0f, 1.5f, 7.0f};
+    for (int simd = 0; simd <= 1; simd++) {
+        set_vector_simd(simd);
+        FloatVector floats;
+        create_float_vector(&floats, 0, NULL, NULL);
+        append_range_float_vector(&floats, values, 10);
+        size_t index;
+        size_t count;
+        find_float_vector(&floats, 0.0f, &index);
+        assert(index == 1);
+        find_float_vector(&floats, not_a_number, &index);
+        assert(index == floats.size);
+        count_float_vector(&floats, 1.5f, &count);
+        assert(count == 4);
+        assert(!contains_float_vector(&floats, 5.0f));
+        
+        FloatVector same;
+        create_float_vector(&same, 0, NULL, NULL);
+        append_range_float_vector(&same, values, 10);
+        assert(!is_equal_float_vector(&floats, &same));
+        erase_range_float_vector(&floats, 4, 1);
+        erase_range_float_vector(&same, 4, 1);
+        assert(is_equal_float_vector(&floats, &same));
+        delete_float_vector(&floats);
+        delete_float_vector(&same);
+    }
+    set_vector_simd(1);
+    
+    const Point points[] = {{1, 2}, {3, 4}, {1, 2}};
+    const Point needle = {1, 2};
+    PointVector point_vec;
+    create_point_vector(&point_vec, 0, NULL, NULL);
+    append_range_point_vector(&point_vec, points, 3);
+    size_t count;
+    count_point_vector(&point_vec, needle, &count);
+    assert(count == 2);
+    delete_point_vector(&point_vec);
+    
+    assert(find_vector(NULL, 0, &count) == VECTOR_ERROR_NULL_POINTER);
+    assert(count_vector(NULL, 0, &count) == VECTOR_ERROR_NULL_POINTER);
+    
+    printf("PASSED\n");
+}
+
+static unsigned int test_random_state = 12345u;
+
+static unsigned int next_test_random(void) {
+    test_random_state ^= test_random_state << 13;
+    test_random_state ^= test_random_state >> 17;
+    test_random_state ^= test_random_state << 5;
+    return test_random_state;
+}
+
+void test_sorted_vector() {
+    printf("Testing sort, lower_bound, insert_sorted and merge... ");
+    
+    const size_t sizes[] = {0, 1, 2, 17, 63, 64, 1000, 5000};
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        Vector vec;
+        DoubleVector doubles;
+        LongLongVector longs;
+        LongVector plain_longs;
+        UShortVector shorts;
+        SizeVector sizes_vec;
+        create_vector(&vec, 0, NULL, NULL);
+        create_double_vector(&doubles, 0, NULL, NULL);
+        create_long_long_vector(&longs, 0, NULL, NULL);
+        create_long_vector(&plain_longs, 0, NULL, NULL);
+        create_ushort_vector(&shorts, 0, NULL, NULL);
+        create_size_vector(&sizes_vec, 0, NULL, NULL);
+        long long sum = 0;
+        for (size_t i = 0; i < sizes[s]; i++) {
+            const int value = (int)next_test_random() % 200 - (i % 3 == 0 ? 100 : 0);
+            push_back_vector(&vec, i % 7 == 0 ? value * 1000000 : value);
+            push_back_double_vector(&doubles, value / 4.0);
+            push_back_long_long_vector(&longs, (long long)value * 10000000000ll);
+            push_back_long_vector(&plain_longs, (long)value * 100000);
+            push_back_ushort_vector(&shorts, (unsigned short)(value * 300));
+            push_back_size_vector(&sizes_vec, (size_t)value << 40);
+            sum += value;
+        }
+        
+        VectorStatus status = sort_vector(&vec);
+        assert(status == VECTOR_SUCCESS);
+        status = sort_double_vector(&doubles);
+        assert(status == VECTOR_SUCCESS);
+        status = sort_long_long_vector(&longs);
+        assert(status == VECTOR_SUCCESS);
+        status = sort_long_vector(&plain_longs);
+        assert(status == VECTOR_SUCCESS);
+        status = sort_ushort_vector(&shorts);
+        assert(status == VECTOR_SUCCESS);
+        status = sort_size_vector(&sizes_vec);
+        assert(status == VECTOR_SUCCESS);
+        long long sorted_sum = 0;
+        for (size_t i = 0; i < sizes[s]; i++) {
+            if (i > 0) {
+                assert(vec.data[i - 1] <= vec.data[i]);
+                assert(doubles.data[i - 1] <= doubles.data[i]);
+                assert(longs.data[i - 1] <= longs.data[i]);
+                assert(plain_longs.data[i - 1] <= plain_longs.data[i]);
+                assert(shorts.data[i - 1] <= shorts.data[i]);
+                assert(sizes_vec.data[i - 1] <= sizes_vec.data[i]);
+            }
+            sorted_sum += longs.data[i] / 10000000000ll;
+        }
+        assert(sorted_sum == sum);
+        
+        for (int needle = -150; needle <= 150; needle += 25) {
+            size_t index;
+            status = lower_bound_vector(&vec, needle, &index);
+            assert(status == VECTOR_SUCCESS);
+            assert(index == vec.size || vec.data[index] >= needle);
+            assert(index == 0 || vec.data[index - 1] < needle);
+        }
+        
+        delete_vector(&vec);
+        delete_double_vector(&doubles);
+        delete_long_long_vector(&longs);
+        delete_long_vector(&plain_longs);
+        delete_ushort_vector(&shorts);
+        delete_size_vector(&sizes_vec);
+    }
+    
+    Vector descending;
+    create_vector(&descending, 0, NULL, NULL);
+    for (int i = 3000; i > 0; i--) {
+        push_back_vector(&descending, i);
+    }
+    VectorStatus status = sort_vector(&descending);
+    assert(status == VECTOR_SUCCESS);
+    for (size_t i = 0; i < descending.size; i++) {
+        assert(descending.data[i] == (int)i + 1);
+    }
+    delete_vector(&descending);
+    
+    Vector odd;
+    Vector even;
+    Vector merged;
+    create_vector(&odd, 0, NULL, NULL);
+    create_vector(&even, 0, NULL, NULL);
+    create_vector(&merged, 0, NULL, NULL);
+    size_t index;
+    for (int i = 9; i >= 0; i--) {
+        insert_sorted_vector(i % 2 ? &odd : &even, i, &index);
+        assert(index == 0);
+    }
+    insert_sorted_vector(&odd, 4, &index);
+    assert(index == 2);
+    status = merge_sorted_vector(&merged, &odd, &even);
+    assert(status == VECTOR_SUCCESS);
+    const int expected[] = {0, 1, 2, 3, 4, 4, 5, 6, 7, 8, 9};
+    assert(merged.size == 11);
+    assert(memcmp(merged.data, expected, sizeof(expected)) == 0);
+    delete_vector(&odd);
+    delete_vector(&even);
+    status = merge_sorted_vector(&merged, &odd, &even);
+    assert(status == VECTOR_SUCCESS);
+    assert(merged.size == 0);
+    delete_vector(&merged);
+    
+    const Point points[] = {{3, 1}, {1, 2}, {3, 0}, {1, 1}};
+    PointVector point_vec;
+    create_point_vector(&point_vec, 0, NULL, NULL);
+    append_range_point_vector(&point_vec, points, 4);
+    sort_point_vector(&point_vec);
+    assert(point_vec.data[0].x == 1 && point_vec.data[0].y == 1);
+    assert(point_vec.data[3].x == 3 && point_vec.data[3].y == 1);
+    delete_point_vector(&point_vec);
+    
+    status = sort_vector(NULL);
+    assert(status == VECTOR_ERROR_NULL_POINTER);
+    status = lower_bound_vector(NULL, 0, &index);
+    assert(status == VECTOR_ERROR_NULL_POINTER);
+    status = merge_sorted_vector(NULL, NULL, NULL);
+    assert(status == VECTOR_ERROR_NULL_POINTER);
+    
+    printf("PASSED\n");
+}
+
+#define PRODUCER_THREADS 8
+#define PRODUCER_PUSHES 20000
+
+typedef struct {
+    ConcurrentVector *vec;
+    int id;
+} ProducerArgs;
+
+static void *produce_values(void *arg) {
+    ProducerArgs *args = (ProducerArgs*)arg;
+    size_t previous = 0;
+    for (int i = 0; i < PRODUCER_PUSHES; i++) {
+        size_t index;
+        VectorStatus status = push_back_concurrent_vector(args->vec, args->id * PRODUCER_PUSHES + i, &index);
+        assert(status == VECTOR_SUCCESS);
+        assert(i == 0 || index > previous);
+        previous = index;
+    }
+    return NULL;
+}
+
+static void *read_ready(void *arg) {
+    ConcurrentVector *vec = (ConcurrentVector*)arg;
+    size_t seen = 0;
+    while (seen < PRODUCER_THREADS * PRODUCER_PUSHES) {
+        const size_t size = size_concurrent_vector(vec);
+        while (seen < size) {
+            int value;
+            VectorStatus status = get_at_concurrent_vector(vec, seen, &value);
+            if (status == VECTOR_ERROR_NOT_READY) {
+                continue;
+            }
+            assert(status == VECTOR_SUCCESS);
+            assert(value >= 0 && value < PRODUCER_THREADS * PRODUCER_PUSHES);
+            seen++;
+        }
+    }
+    return NULL;
+}
+
+void test_concurrent_vector() {
+    printf("Testing concurrent append vector... ");
+    
+    ConcurrentVector vec;
+    VectorStatus status = create_concurrent_vector(&vec);
+    assert(status == VECTOR_SUCCESS);
+    assert(size_concurrent_vector(&vec) == 0);
+    
+    pthread_t reader;
+    pthread_t producers[PRODUCER_THREADS];
+    ProducerArgs args[PRODUCER_THREADS];
+    int rc = pthread_create(&reader, NULL, read_ready, &vec);
+    assert(rc == 0);
+    for (int t = 0; t < PRODUCER_THREADS; t++) {
+        args[t].vec = &vec;
+        args[t].id = t;
+        rc = pthread_create(&producers[t], NULL, produce_values, &args[t]);
+        assert(rc == 0);
+    }
+    for (int t = 0; t < PRODUCER_THREADS; t++) {
+        pthread_join(producers[t], NULL);
+    }
+    pthread_join(reader, NULL);
+    
+    const size_t total = PRODUCER_THREADS * PRODUCER_PUSHES;
+    assert(size_concurrent_vector(&vec) == total);
+    char *seen = (char*)calloc(total, 1);
+    assert(seen != NULL);
+    for (size_t i = 0; i < total; i++) {
+        int value;
+        status = get_at_concurrent_vector(&vec, i, &value);
+        assert(status == VECTOR_SUCCESS);
+        assert(!seen[value]);
+        seen[value] = 1;
+    }
+    free(seen);
+    
+    int value;
+    status = get_at_concurrent_vector(&vec, total, &value);
+    assert(status == VECTOR_ERROR_INDEX_OUT_OF_BOUNDS);
+    delete_concurrent_vector(&vec);
+    assert(size_concurrent_vector(&vec) == 0);
+    
+    create_concurrent_vector(&vec);
+    status = reserve_concurrent_vector(&vec, 1000);
+    assert(status == VECTOR_SUCCESS);
+    ConcurrentVectorSlot *first_segment = vec.segments[0];
+    for (int i = 0; i < 1000; i++) {
+        push_back_concurrent_vector(&vec, i, NULL);
+    }
+    assert(vec.segments[0] == first_segment);
+    get_at_concurrent_vector(&vec, 999, &value);
+    assert(value == 999);
+    
+    /* A slot whose producer never finished does not block later appends. */
+    vec.reserved++;
+    size_t index;
+    status = push_back_concurrent_vector(&vec, 1001, &index);
+    assert(status == VECTOR_SUCCESS && index == 1001);
+    status = get_at_concurrent_vector(&vec, 1000, &value);
+    assert(status == VECTOR_ERROR_NOT_READY);
+    status = get_at_concurrent_vector(&vec, 1001, &value);
+    assert(status == VECTOR_SUCCESS && value == 1001);
+    assert(size_concurrent_vector(&vec) == 1002);
+    delete_concurrent_vector(&vec);
+    
+    status = push_back_concurrent_vector(NULL, 1, NULL);
+    assert(status == VECTOR_ERROR_NULL_POINTER);
+    status = get_at_concurrent_vector(NULL, 0, &value);
+    assert(status == VECTOR_ERROR_NULL_POINTER);
+    
+    printf("PASSED\n");
+}
+
+#define MAPPED_TEST_PATH "test_mapped_vector.bin"
+
+void test_mapped_vector() {
+    printf("Testing file-backed mapped vector... ");
+    
+    remove(MAPPED_TEST_PATH);
+    MappedVector vec;
+    VectorStatus status = open_mapped_vector(&vec, MAPPED_TEST_PATH);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.size == 0);
+    
+    for (int i = 0; i < 5000; i++) {
+        status = push_back_mapped_vector(&vec, i * 3);
+        assert(status == VECTOR_SUCCESS);
+    }
+    assert(vec.size == 5000);
+    assert(vec.capacity >= 5000);
+    status = close_mapped_vector(&vec);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.data == NULL);
+    
+    status = open_mapped_vector(&vec, MAPPED_TEST_PATH);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.size == 5000);
+    for (int i = 0; i < 5000; i++) {
+        assert(vec.data[i] == i * 3);
+    }
+    int value;
+    status = get_at_mapped_vector(&vec, 4999, &value);
+    assert(status == VECTOR_SUCCESS && value == 4999 * 3);
+    status = get_at_mapped_vector(&vec, 5000, &value);
+    assert(status == VECTOR_ERROR_INDEX_OUT_OF_BOUNDS);
+    
+    int more[] = {-1, -2, -3};
+    status = append_range_mapped_vector(&vec, more, 3);
+    assert(status == VECTOR_SUCCESS);
+    status = sync_mapped_vector(&vec);
+    assert(status == VECTOR_SUCCESS);
+    close_mapped_vector(&vec);
+    
+    open_mapped_vector(&vec, MAPPED_TEST_PATH);
+    assert(vec.size == 5003);
+    assert(vec.data[5002] == -3);
+    erase_mapped_vector(&vec);
+    close_mapped_vector(&vec);
+    
+    open_mapped_vector(&vec, MAPPED_TEST_PATH);
+    assert(vec.size == 0);
+    close_mapped_vector(&vec);
+    status = close_mapped_vector(&vec);
+    assert(status == VECTOR_ERROR_NULL_POINTER);
+    
+    FILE *file = fopen(MAPPED_TEST_PATH, "wb");
+    assert(file != NULL);
+    for (int i = 0; i < 100; i++) {
+        fputc('x', file);
+    }
+    fclose(file);
+    status = open_mapped_vector(&vec, MAPPED_TEST_PATH);
+    assert(status == VECTOR_ERROR_INVALID_FILE);
+    
+    remove(MAPPED_TEST_PATH);
+    printf("PASSED\n");
+}
+
+#define SERIALIZED_TEST_PATH "test_serialized_vector.bin"
+
+static long file_size(const char *path) {
+    FILE *file = fopen(path, "rb");
+    assert(file != NULL);
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fclose(file);
+    return size;
+}
+
+void test_serialized_vector() {
+    printf("Testing binary save and load... ");
+    
+    Vector vec, loaded;
+    create_vector(&vec, 0, NULL, NULL);
+    create_vector(&loaded, 4, NULL, NULL);
+    for (int i = 0; i < 10000; i++) {
+        push_back_vector(&vec, i * 7 - 5000);
+    }
+    push_back_vector(&loaded, 42);
+    
+    VectorStatus status = save_vector(&vec, SERIALIZED_TEST_PATH, VECTOR_ENCODING_RAW);
+    assert(status == VECTOR_SUCCESS);
+    const long raw_size = file_size(SERIALIZED_TEST_PATH);
+    assert(raw_size == (long)(sizeof(VectorBinaryHeader) + 10000 * sizeof(int)));
+    status = load_vector(&loaded, SERIALIZED_TEST_PATH);
+    assert(status == VECTOR_SUCCESS);
+    assert(is_equal_vector(&vec, &loaded));
+    
+    status = save_vector(&vec, SERIALIZED_TEST_PATH, VECTOR_ENCODING_DELTA_VARINT);
+    assert(status == VECTOR_SUCCESS);
+    assert(file_size(SERIALIZED_TEST_PATH) < raw_size / 3);
+    erase_vector(&loaded);
+    status = load_vector(&loaded, SERIALIZED_TEST_PATH);
+    assert(status == VECTOR_SUCCESS);
+    assert(is_equal_vector(&vec, &loaded));
+    
+    FILE *file = fopen(SERIALIZED_TEST_PATH, "r+b");
+    assert(file != NULL);
+    fseek(file, (long)sizeof(VectorBinaryHeader) + 10, SEEK_SET);
+    fputc(0x7F, file);
+    fclose(file);
+    status = load_vector(&loaded, SERIALIZED_TEST_PATH);
+    assert(status == VECTOR_ERROR_INVALID_FILE);
+    assert(loaded.size == 0);
+    
+    erase_vector(&vec);
+    save_vector(&vec, SERIALIZED_TEST_PATH, VECTOR_ENCODING_DELTA_VARINT);
+    push_back_vector(&loaded, 1);
+    status = load_vector(&loaded, SERIALIZED_TEST_PATH);
+    assert(status == VECTOR_SUCCESS);
+    assert(loaded.size == 0);
+    
+    LongLongVector wide, wide_loaded;
+    create_long_long_vector(&wide, 0, NULL, NULL);
+    create_long_long_vector(&wide_loaded, 0, NULL, NULL);
+    push_back_long_long_vector(&wide, 0x7FFFFFFFFFFFFFFFll);
+    push_back_long_long_vector(&wide, -0x7FFFFFFFFFFFFFFFll - 1);
+    push_back_long_long_vector(&wide, 3);
+    save_long_long_vector(&wide, SERIALIZED_TEST_PATH, VECTOR_ENCODING_DELTA_VARINT);
+    status = load_long_long_vector(&wide_loaded, SERIALIZED_TEST_PATH);
+    assert(status == VECTOR_SUCCESS);
+    assert(is_equal_long_long_vector(&wide, &wide_loaded));
+    status = load_vector(&loaded, SERIALIZED_TEST_PATH);
+    assert(status == VECTOR_ERROR_INVALID_FILE);
+    
+    DoubleVector reals, reals_loaded;
+    create_double_vector(&reals, 0, NULL, NULL);
+    create_double_vector(&reals_loaded, 0, NULL, NULL);
+    push_back_double_vector(&reals, 0.5);
+    push_back_double_vector(&reals, -2.25);
+    save_double_vector(&reals, SERIALIZED_TEST_PATH, VECTOR_ENCODING_DELTA_VARINT);
+    assert(file_size(SERIALIZED_TEST_PATH) == (long)(sizeof(VectorBinaryHeader) + 2 * sizeof(double)));
+    status = load_double_vector(&reals_loaded, SERIALIZED_TEST_PATH);
+    assert(status == VECTOR_SUCCESS);
+    assert(is_equal_double_vector(&reals, &reals_loaded));
+    
+    push_back_vector(&vec, 1);
+    push_back_vector(&vec, 2);
+    save_vector(&vec, SERIALIZED_TEST_PATH, VECTOR_ENCODING_RAW);
+    VectorBinaryHeader header;
+    file = fopen(SERIALIZED_TEST_PATH, "r+b");
+    assert(file != NULL);
+    size_t items = fread(&header, sizeof(header), 1, file);
+    assert(items == 1);
+    header.size = 1ull << 36;
+    header.payload_bytes = header.size * sizeof(int);
+    rewind(file);
+    items = fwrite(&header, sizeof(header), 1, file);
+    assert(items == 1);
+    fclose(file);
+    erase_vector(&loaded);
+    push_back_vector(&loaded, 9);
+    const size_t loaded_capacity = loaded.capacity;
+    status = load_vector(&loaded, SERIALIZED_TEST_PATH);
+    assert(status == VECTOR_ERROR_INVALID_FILE);
+    assert(loaded.size == 1 && loaded.data[0] == 9);
+    assert(loaded.capacity == loaded_capacity);
+    
+    remove(SERIALIZED_TEST_PATH);
+    status = load_vector(&loaded, SERIALIZED_TEST_PATH);
+    assert(status == VECTOR_ERROR_IO);
+    status = save_vector(NULL, SERIALIZED_TEST_PATH, VECTOR_ENCODING_RAW);
+    assert(status == VECTOR_ERROR_NULL_POINTER);
+    
+    delete_vector(&vec);
+    delete_vector(&loaded);
+    delete_long_long_vector(&wide);
+    delete_long_long_vector(&wide_loaded);
+    delete_double_vector(&reals);
+    delete_double_vector(&reals_loaded);
+    printf("PASSED\n");
+}
+
+void test_copy_on_write_vector() {
+    printf("Testing copy-on-write copies... ");
+    
+    Vector vec;
+    VectorStatus status = create_vector(&vec, 0, copy_int, count_delete_int);
+    assert(status == VECTOR_SUCCESS);
+    for (int i = 0; i < 1000; i++) {
+        push_back_vector(&vec, i);
+    }
+    status = set_copy_on_write_vector(&vec, 1);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.shared && *vec.shared == 1);
+    
+    Vector *first = NULL;
+    Vector *second = NULL;
+    status = copy_vector_new(&vec, &first);
+    assert(status == VECTOR_SUCCESS);
+    assert(first->data == vec.data);
+    assert(*vec.shared == 2);
+    copy_vector_new(&vec, &second);
+    assert(second->data == vec.data);
+    assert(*vec.shared == 3);
+    assert(is_equal_vector(&vec, second));
+    
+    status = push_back_vector(first, 1000);
+    assert(status == VECTOR_SUCCESS);
+    assert(first->data != vec.data);
+    assert(first->shared != vec.shared && *first->shared == 1);
+    assert(first->size == 1001 && vec.size == 1000);
+    assert(*vec.shared == 2);
+    
+    deleted_count = 0;
+    delete_vector(second);
+    free(second);
+    assert(deleted_count == 0);
+    assert(*vec.shared == 1);
+    
+    int *data = vec.data;
+    int value;
+    status = delete_at_vector(&vec, 0, &value);
+    assert(status == VECTOR_SUCCESS && value == 0);
+    assert(vec.data == data);
+    assert(*vec.shared == 1);
+    assert(deleted_count == 1);
+    get_at_vector(first, 0, &value);
+    assert(value == 0);
+    
+    copy_vector_new(&vec, &second);
+    size_t *count = vec.shared;
+    status = erase_vector(second);
+    assert(status == VECTOR_SUCCESS);
+    assert(second->copy_on_write && second->shared != count);
+    assert(*count == 1 && *second->shared == 1);
+    delete_vector(second);
+    free(second);
+    
+    copy_vector_new(&vec, &second);
+    deleted_count = 0;
+    delete_vector(&vec);
+    assert(deleted_count == 0);
+    get_at_vector(second, 998, &value);
+    assert(value == 999);
+    delete_vector(second);
+    free(second);
+    assert(deleted_count == 999);
+    delete_vector(first);
+    free(first);
+    
+    SmallVector small;
+    create_small_vector(&small, NULL, NULL);
+    set_copy_on_write_vector(&small.vector, 1);
+    push_back_vector(&small.vector, 7);
+    copy_vector_new(&small.vector, &first);
+    assert(first->data != small.vector.data);
+    assert(first->shared != small.vector.shared);
+    assert(*first->shared == 1 && *small.vector.shared == 1);
+    delete_vector(first);
+    free(first);
+    delete_vector(&small.vector);
+    
+    create_vector(&vec, 4, NULL, NULL);
+    push_back_vector(&vec, 1);
+    copy_vector_new(&vec, &first);
+    assert(first->data != vec.data);
+    assert(first->shared == NULL);
+    delete_vector(first);
+    free(first);
+    
+    set_copy_on_write_vector(&vec, 1);
+    copy_vector_new(&vec, &first);
+    status = set_copy_on_write_vector(&vec, 0);
+    assert(status == VECTOR_SUCCESS);
+    assert(vec.shared == NULL && vec.data != first->data);
+    assert(*first->shared == 1);
+    delete_vector(first);
+    free(first);
+    delete_vector(&vec);
+    
+    status = detach_vector(NULL);
+    assert(status == VECTOR_ERROR_NULL_POINTER);
+    printf("PASSED\n");
+}
+
+void test_pool_allocator() {
+    printf("Testing pool allocator... ");
+    
+    VectorPool pool;
+    vector_pool_init(&pool, 4);
+    const VectorAllocator allocator = vector_pool_allocator(&pool);
+    
+    Vector vec;
+    VectorStatus status = create_with_allocator_vector(&vec, 0, NULL, NULL, &allocator);
+    assert(status == VECTOR_SUCCESS);
+    for (int i = 0; i < 100; i++) {
+        push_back_vector(&vec, i);
+    }
+    delete_vector(&vec);
+    const size_t first_allocations = pool.system_allocations;
+    assert(first_allocations > 0);
+    
+    create_with_allocator_vector(&vec, 0, NULL, NULL, &allocator);
+    for (int i = 0; i < 100; i++) {
+        push_back_vector(&vec, i * 2);
+    }
+    assert(pool.system_allocations == first_allocations);
+    assert(pool.reused > 0);
+    for (int i = 0; i < 100; i++) {
+        int value;
+        get_at_vector(&vec, (size_t)i, &value);
+        assert(value == i * 2);
+    }
+    
+    Vector *copy = NULL;
+    status = copy_vector_new(&vec, &copy);
+    assert(status == VECTOR_SUCCESS);
+    assert(copy->allocator == &allocator);
+    assert(is_equal_vector(&vec, copy));
+    shrink_to_fit_vector(copy);
+    assert(copy->capacity == 100);
+    delete_vector(copy);
+    free(copy);
+    delete_vector(&vec);
+    
+    Vector many[10];
+    for (int n = 0; n < 10; n++) {
+        create_with_allocator_vector(&many[n], 8, NULL, NULL, &allocator);
+    }
+    for (int n = 0; n < 10; n++) {
+        delete_vector(&many[n]);
+    }
+    assert(pool.cached[1] == 4);
+    
+    create_with_allocator_vector(&vec, 0, NULL, NULL, &allocator);
+    for (int i = 0; i < 20000; i++) {
+        push_back_vector(&vec, i);
+    }
+    assert(vec.capacity * sizeof(int) > VECTOR_POOL_MAX_BLOCK);
+    int value;
+    get_at_vector(&vec, 19999, &value);
+    assert(value == 19999);
+    delete_vector(&vec);
+    
+    vector_pool_destroy(&pool);
+    assert(pool.cached[1] == 0);
+    printf("PASSED\n");
+}
+
 void run_all_tests() {
     printf("Running comprehensive vector tests...\n\n");
     
@@ -858,6 +2019,19 @@ void run_all_tests() {
     test_delete_vector();
     test_edge_cases();
     test_zero_and_negative();
+    test_small_vector();
+    test_capacity_management();
+    test_range_operations();
+    test_unordered_removal();
+    test_vector_template();
+    test_trivial_vector();
+    test_search_vector();
+    test_sorted_vector();
+    test_concurrent_vector();
+    test_mapped_vector();
+    test_serialized_vector();
+    test_copy_on_write_vector();
+    test_pool_allocator();
     
     printf("\nAll tests passed!\n");
 }